@@ -0,0 +1,215 @@
+// This example runs a multi-step workflow (reset, write and verify settings, self-calibrate, capture a batch
+// of samples, then reconfigure and repeat) as straight-line code that never blocks, while loop() keeps
+// blinking an LED.  The workflow is a protothread; with C++20 coroutines available, loop() instead runs the
+// same steps written as an ADS1256Coroutine (see capture_workflow_coroutine below).
+
+#include <ADS1256_async.h>
+#include <ADS1256_constants.h>
+#include <ADS1256_diagnostics.h>
+#include <ADS1256_workflow.h>
+
+#define LED_PIN (2)
+#define BLINK_PERIOD_MS (50)
+#define BATCH_SAMPLES (20)
+#define STEP_TIMEOUT_MS (2000)
+
+// Assumes ADS1256 is connected to SPI pins for SCLK, MOSI, and MISO
+const uint8_t ADC_PIN_DRDY = 4;
+const uint8_t ADC_PIN_CS = 22;
+const uint8_t ADC_PIN_RESET = 18;  // This can be either the dedicated RST pin, or the SCLK pin (based on ADC_RESET_MODE below)
+const ADS1256ResetMode ADC_RESET_MODE = ADS1256ResetMode::ClockPin;
+
+ADS1256<2> adc(ADC_PIN_DRDY, ADC_PIN_CS, ADC_PIN_RESET, ADC_RESET_MODE);
+
+ADS1256Protothread workflow;
+uint16_t n_samples;  // Not a local variable, since locals do not survive awaits
+int64_t sums[2];
+
+void report_error(const __FlashStringHelper* step) {
+  Serial.print("Timeout or error while ");
+  Serial.println(step);
+}
+
+// Returns true when the workflow has finished (and then starts over on the next call)
+bool capture_workflow() {
+  ADS1256_PT_BEGIN(workflow);
+
+  adc.beginReset();
+  ADS1256_PT_AWAIT_TIMEOUT(workflow, poll_idle(adc), STEP_TIMEOUT_MS);
+  if (workflow.timed_out) {
+    report_error(F("resetting"));
+    ADS1256_PT_EXIT(workflow);
+  }
+
+  ADS1256_PT_AWAIT_TIMEOUT(workflow, poll_data_ready(adc), STEP_TIMEOUT_MS);
+  if (workflow.timed_out || adc.beginWriteSettings(0) != ADS1256Error::None) {
+    report_error(F("beginning to write settings"));
+    ADS1256_PT_EXIT(workflow);
+  }
+  ADS1256_PT_AWAIT_TIMEOUT(workflow, poll_idle(adc), STEP_TIMEOUT_MS);
+  if (workflow.timed_out) {
+    report_error(F("writing settings"));
+    ADS1256_PT_EXIT(workflow);
+  }
+
+  // Verify settings
+  ADS1256_PT_AWAIT_TIMEOUT(workflow, poll_data_ready(adc), STEP_TIMEOUT_MS);
+  if (workflow.timed_out || adc.readSettings(false, 0) != ADS1256Error::None) {
+    report_error(F("verifying settings"));
+    ADS1256_PT_EXIT(workflow);
+  }
+
+  ADS1256_PT_AWAIT_TIMEOUT(workflow, poll_data_ready(adc), STEP_TIMEOUT_MS);
+  if (workflow.timed_out || adc.beginSelfCalibration(0) != ADS1256Error::None) {
+    report_error(F("beginning to calibrate"));
+    ADS1256_PT_EXIT(workflow);
+  }
+  ADS1256_PT_AWAIT_TIMEOUT(workflow, poll_idle(adc), STEP_TIMEOUT_MS);
+  if (workflow.timed_out) {
+    report_error(F("calibrating"));
+    ADS1256_PT_EXIT(workflow);
+  }
+
+  ADS1256_PT_AWAIT_TIMEOUT(workflow, poll_data_ready(adc), STEP_TIMEOUT_MS);
+  adc.new_data = ADS1256_NO_NEW_DATA;  // Discard any sample left from the last run
+  if (workflow.timed_out || adc.beginCapture(0) != ADS1256Error::None) {
+    report_error(F("beginning to capture"));
+    ADS1256_PT_EXIT(workflow);
+  }
+  n_samples = 0;
+  sums[0] = sums[1] = 0;
+  while (n_samples < BATCH_SAMPLES) {
+    ADS1256_PT_AWAIT_TIMEOUT(workflow, poll_new_data(adc), STEP_TIMEOUT_MS);
+    if (workflow.timed_out) {
+      // The next run resets the ADS1256
+      report_error(F("capturing"));
+      ADS1256_PT_EXIT(workflow);
+    }
+    sums[adc.new_data] += adc.value(adc.new_data);
+    adc.new_data = ADS1256_NO_NEW_DATA;
+    n_samples++;
+  }
+  adc.endCapture();
+  ADS1256_PT_AWAIT_TIMEOUT(workflow, poll_idle(adc), STEP_TIMEOUT_MS);
+  if (workflow.timed_out) {
+    report_error(F("ending capture"));
+    ADS1256_PT_EXIT(workflow);
+  }
+
+  Serial.print(name_of(adc.data_rate));
+  Serial.print(": mean AIN0 ");
+  Serial.print((float)sums[0] / (BATCH_SAMPLES / 2));
+  Serial.print(", AIN1 ");
+  Serial.println((float)sums[1] / (BATCH_SAMPLES / 2));
+
+  // Reconfigure for the next run
+  adc.data_rate = adc.data_rate == DataRate::SPS100 ? DataRate::SPS1000 : DataRate::SPS100;
+
+  ADS1256_PT_END(workflow);
+}
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+// The same workflow as a C++20 coroutine; drive it with coroutine.poll().  Each wait_* returns false if
+// STEP_TIMEOUT_MS passed before its condition was met.
+ADS1256Coroutine capture_workflow_coroutine() {
+  adc.beginReset();
+  if (!co_await wait_idle(adc, STEP_TIMEOUT_MS)) {
+    report_error(F("resetting"));
+    co_return;
+  }
+
+  bool ready = co_await wait_data_ready(adc, STEP_TIMEOUT_MS);
+  if (!ready || adc.beginWriteSettings(0) != ADS1256Error::None) {
+    report_error(F("beginning to write settings"));
+    co_return;
+  }
+  if (!co_await wait_idle(adc, STEP_TIMEOUT_MS)) {
+    report_error(F("writing settings"));
+    co_return;
+  }
+
+  // Verify settings
+  ready = co_await wait_data_ready(adc, STEP_TIMEOUT_MS);
+  if (!ready || adc.readSettings(false, 0) != ADS1256Error::None) {
+    report_error(F("verifying settings"));
+    co_return;
+  }
+
+  ready = co_await wait_data_ready(adc, STEP_TIMEOUT_MS);
+  if (!ready || adc.beginSelfCalibration(0) != ADS1256Error::None) {
+    report_error(F("beginning to calibrate"));
+    co_return;
+  }
+  if (!co_await wait_idle(adc, STEP_TIMEOUT_MS)) {
+    report_error(F("calibrating"));
+    co_return;
+  }
+
+  ready = co_await wait_data_ready(adc, STEP_TIMEOUT_MS);
+  adc.new_data = ADS1256_NO_NEW_DATA;  // Discard any sample left from the last run
+  if (!ready || adc.beginCapture(0) != ADS1256Error::None) {
+    report_error(F("beginning to capture"));
+    co_return;
+  }
+  int64_t coroutine_sums[2] = {0, 0};  // Locals of a coroutine do survive awaits
+  for (uint16_t i = 0; i < BATCH_SAMPLES; i++) {
+    if (!co_await wait_new_data(adc, STEP_TIMEOUT_MS)) {
+      report_error(F("capturing"));
+      co_return;
+    }
+    coroutine_sums[adc.new_data] += adc.value(adc.new_data);
+    adc.new_data = ADS1256_NO_NEW_DATA;
+  }
+  adc.endCapture();
+  if (!co_await wait_idle(adc, STEP_TIMEOUT_MS)) {
+    report_error(F("ending capture"));
+    co_return;
+  }
+
+  Serial.print(name_of(adc.data_rate));
+  Serial.print(": mean AIN0 ");
+  Serial.print((float)coroutine_sums[0] / (BATCH_SAMPLES / 2));
+  Serial.print(", AIN1 ");
+  Serial.println((float)coroutine_sums[1] / (BATCH_SAMPLES / 2));
+
+  // Reconfigure for the next run
+  adc.data_rate = adc.data_rate == DataRate::SPS100 ? DataRate::SPS1000 : DataRate::SPS100;
+}
+
+ADS1256Coroutine coroutine;  // Started by loop(), since a coroutine runs until its first wait when called
+#endif
+
+void setup() {
+  delay(2000);
+
+  Serial.begin(115200);
+  Serial.println("ADS1256_async: async_workflow");
+
+  pinMode(LED_PIN, OUTPUT);
+  digitalWrite(LED_PIN, LOW);
+
+  adc.data_rate = DataRate::SPS100;
+  adc.muxes[0] = mux_of(0);  // AIN0
+  adc.muxes[1] = mux_of(1);  // AIN1
+}
+
+unsigned long last_blink;
+bool led_high;
+
+void loop() {
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+  if (coroutine.poll()) {
+    // Finished (or not yet started), so start the next run
+    coroutine = capture_workflow_coroutine();
+  }
+#else
+  capture_workflow();
+#endif
+
+  // Other cooperative work keeps running while the workflow waits on the ADS1256
+  if (millis() - last_blink >= BLINK_PERIOD_MS) {
+    led_high = !led_high;
+    digitalWrite(LED_PIN, led_high ? HIGH : LOW);
+    last_blink = millis();
+  }
+}
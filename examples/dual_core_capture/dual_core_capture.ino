@@ -0,0 +1,77 @@
+// This example (ESP32 only) runs ADS1256 acquisition on core 0 while loop() processes completed blocks of
+// samples on core 1.
+
+#include <ADS1256_async.h>
+#include <ADS1256_constants.h>
+#include <ADS1256_diagnostics.h>
+#include <ADS1256_runner.h>
+
+// Assumes ADS1256 is connected to SPI pins for SCLK, MOSI, and MISO
+const uint8_t ADC_PIN_DRDY = 4;
+const uint8_t ADC_PIN_CS = 22;
+const uint8_t ADC_PIN_RESET = 18;  // This can be either the dedicated RST pin, or the SCLK pin (based on ADC_RESET_MODE below)
+const ADS1256ResetMode ADC_RESET_MODE = ADS1256ResetMode::ClockPin;
+
+#define N_CHANNELS 2
+#define BLOCK_SAMPLES 256
+ADS1256<N_CHANNELS> adc(ADC_PIN_DRDY, ADC_PIN_CS, ADC_PIN_RESET, ADC_RESET_MODE);
+ADS1256CaptureRunner<N_CHANNELS, BLOCK_SAMPLES> runner(adc);
+
+void setup() {
+  delay(2000);
+
+  Serial.begin(115200);
+  Serial.println("ADS1256_async: dual_core_capture");
+
+  adc.auto_calibration = true;
+  adc.data_rate = DataRate::SPS30000;
+  adc.muxes[0] = mux_of(0);  // AIN0
+  adc.muxes[1] = mux_of(1);  // AIN1
+
+  ADS1256Error result = adc.blockingInit();
+  if (result == ADS1256Error::None) {
+    result = adc.beginCapture();
+  }
+  if (result != ADS1256Error::None) {
+    Serial.print("Unable to start capture: ");
+    Serial.println(name_of(result));
+    while (true) {}
+  }
+
+  // From here on, only the runner's task may touch adc
+  if (!runner.start(0)) {
+    Serial.println("Unable to start acquisition task");
+    while (true) {}
+  }
+}
+
+void loop() {
+  const ADS1256CaptureRunner<N_CHANNELS, BLOCK_SAMPLES>::Block* block = runner.acquire();
+  if (!block) {
+    // No block ready yet; do other work here
+    return;
+  }
+
+  if (block->dropped) {
+    Serial.print("Processing fell behind; dropped ");
+    Serial.print(block->dropped);
+    Serial.println(" samples");
+  }
+
+  uint32_t sequence = block->sequence;
+  int64_t sum[N_CHANNELS] = {0};
+  uint16_t n[N_CHANNELS] = {0};
+  for (uint16_t i = 0; i < block->n_samples; i++) {
+    sum[block->channels[i]] += block->value(i);
+    n[block->channels[i]]++;
+  }
+  runner.release();  // block must not be used after this
+
+  Serial.print("Block ");
+  Serial.print(sequence);
+  for (uint8_t c = 0; c < N_CHANNELS; c++) {
+    Serial.print(c == 0 ? ": mean " : ", ");
+    Serial.print(n[c] ? (float)sum[c] / n[c] : 0);
+  }
+  Serial.println();
+}
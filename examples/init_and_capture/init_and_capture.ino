@@ -169,7 +169,7 @@ void loop() {
   Serial.println(" samples/sec)");
   for (uint8_t c = 0; c < N_CHANNELS; c++) {
     Serial.print("  ");
-    Serial.print(name_of_mux(adc.muxes[c]));
+    print_mux(Serial, adc.muxes[c]);
     Serial.print(" = ");
     Serial.print(adc.values[c]);
     Serial.print(" most recently (");
@@ -0,0 +1,199 @@
+#ifndef ADS1256_REPLAY_H
+#define ADS1256_REPLAY_H
+
+// HostBus that feeds a recorded ADS1256 trace (see ADS1256_trace.h) back to the driver.
+//
+// SPI transfers return the recorded MISO bytes and DRDY reads return the recorded edges, so the driver
+// follows the same path it did on hardware.  Everything the driver does is compared to the recording:
+// operations are matched in order by kind, recorded operations the driver skipped are counted as missing,
+// and operations that have no recorded counterpart are counted as extra.  The virtual clock follows the
+// recorded timestamps so timeouts behave as they did when recording.
+
+#include "Arduino.h"
+#include <ADS1256_trace.h>
+
+struct ADS1256ReplayResult {
+	uint32_t matched = 0;  // Operations identical to the recording
+	uint32_t mismatched = 0;  // Operations of the recorded kind but with different bytes, pins, or levels
+	uint32_t missing = 0;  // Recorded operations the driver did not perform
+	uint32_t extra = 0;  // Operations the driver performed that were not recorded
+	uint32_t recorded_delay_us = 0;
+	uint32_t replayed_delay_us = 0;
+	uint32_t first_divergence = 0xFFFFFFFF;  // Index of the first record that was not matched exactly
+
+	inline bool identical() const {
+		return mismatched == 0 && missing == 0 && extra == 0 && recorded_delay_us == replayed_delay_us;
+	}
+};
+
+class ADS1256ReplayBus : public HostBus {
+  public:
+	ADS1256ReplayBus(const uint8_t* data, size_t size) : reader_(data, size), origin_us_(host_clock_us()) {
+		for (uint16_t p = 0; p < 256; p++) {
+			levels_[p] = HIGH;
+		}
+		has_next_ = reader_.next(next_);
+	}
+
+	ADS1256ReplayResult result;
+
+	// True once every recorded operation has been consumed
+	inline bool finished() const {
+		return !has_next_;
+	}
+
+	inline uint32_t position() const {
+		return index_;
+	}
+
+	void digitalWrite(uint8_t pin, uint8_t level) override {
+		if (seek(ADS1256TraceEvent::PinWrite)) {
+			compare(next_.pin == pin && next_.level == (level ? 1 : 0));
+			advance();
+		}
+	}
+
+	int digitalRead(uint8_t pin) override {
+		if (has_next_ && next_.event == ADS1256TraceEvent::PinRead && next_.pin == pin) {
+			levels_[pin] = next_.level;
+			advance();
+		}
+		return levels_[pin];
+	}
+
+	void beginTransaction() override {
+		if (seek(ADS1256TraceEvent::BeginTransaction)) {
+			compare(true);
+			advance();
+		}
+	}
+
+	void endTransaction() override {
+		if (seek(ADS1256TraceEvent::EndTransaction)) {
+			compare(true);
+			advance();
+		}
+	}
+
+	uint8_t transfer(uint8_t mosi) override {
+		if (!seek(ADS1256TraceEvent::SpiTransfer)) {
+			return 0xFF;
+		}
+		compare(next_.mosi == mosi);
+		uint8_t miso = next_.miso;
+		advance();
+		return miso;
+	}
+
+	void delayMicroseconds(unsigned int us) override {
+		result.replayed_delay_us += us;
+		if (seek(ADS1256TraceEvent::Delay)) {
+			result.recorded_delay_us += next_.delay_us;
+			compare(next_.delay_us == us);
+			advance();
+		} else {
+			host_advance_us(us);
+		}
+	}
+
+  private:
+	ADS1256TraceReader reader_;
+	ADS1256TraceRecord next_;
+	bool has_next_;
+	uint32_t index_ = 0;
+	uint64_t origin_us_;
+	uint8_t levels_[256];
+
+	void advance() {
+		host_advance_to_us(origin_us_ + next_.t_us);
+		index_++;
+		has_next_ = reader_.next(next_);
+	}
+
+	void diverge() {
+		if (result.first_divergence == 0xFFFFFFFF) {
+			result.first_divergence = index_;
+		}
+	}
+
+	void compare(bool same) {
+		if (same) {
+			result.matched++;
+		} else {
+			result.mismatched++;
+			diverge();
+		}
+	}
+
+	// Positions next_ on the next recorded operation of this kind, counting skipped operations as missing.
+	// Returns false (and counts an extra operation) if the rest of the recording has no such operation.
+	bool seek(ADS1256TraceEvent event) {
+		if (has_next_ && next_.event == event) {
+			return true;
+		}
+		ADS1256TraceReader ahead = reader_;
+		ADS1256TraceRecord record = next_;
+		uint8_t levels[256];
+		memcpy(levels, levels_, sizeof(levels));
+		uint32_t skipped = 0;
+		uint32_t n = 0;
+		bool found = false;
+		while (has_next_) {
+			// record is the operation being skipped
+			if (record.event == ADS1256TraceEvent::PinRead) {
+				levels[record.pin] = record.level;
+			} else {
+				skipped++;
+			}
+			n++;
+			if (!ahead.next(record)) {
+				break;
+			}
+			if (record.event == event) {
+				found = true;
+				break;
+			}
+		}
+		if (!found) {
+			result.extra++;
+			diverge();
+			return false;
+		}
+		if (skipped) {
+			result.missing += skipped;
+			diverge();
+		}
+		reader_ = ahead;
+		next_ = record;
+		memcpy(levels_, levels, sizeof(levels_));
+		index_ += n;
+		return true;
+	}
+};
+
+// Session callback (see ADS1256_session.h) that ends a replay once the recording has been consumed, or once
+// max_idle_updates calls to update() pass without the driver consuming any of it (stalled is then set)
+struct ADS1256ReplayProgress {
+	ADS1256ReplayBus* bus;
+	uint32_t max_idle_updates = 1000000;
+	bool stalled = false;
+	uint32_t position = 0;
+	uint32_t idle_updates = 0;
+
+	static bool more(uint32_t, void* self) {
+		ADS1256ReplayProgress* progress = (ADS1256ReplayProgress*)self;
+		if (progress->bus->finished()) {
+			return false;
+		}
+		if (progress->bus->position() != progress->position) {
+			progress->position = progress->bus->position();
+			progress->idle_updates = 0;
+		} else if (++progress->idle_updates >= progress->max_idle_updates) {
+			progress->stalled = true;
+			return false;
+		}
+		return true;
+	}
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef ADS1256_SESSION_H
+#define ADS1256_SESSION_H
+
+// Runs the driver the way a recording sketch does (blockingInit(), beginCapture(), then update() until
+// told to stop), so the same session can be recorded through a simulated ADS1256 and replayed from its
+// trace (see ADS1256_replay.h).  The configuration is data rather than code, so tools can take it from the
+// command line; nCycledChannels is a template parameter of the driver, so run_session dispatches on
+// n_channels.
+
+#ifndef ADS1256_TRACE
+#error "Define ADS1256_TRACE before including ADS1256_session.h"
+#endif
+
+#include <stdlib.h>
+
+#include <ADS1256_async.h>
+#include <ADS1256_trace.h>
+
+#define ADS1256_SESSION_MAX_CHANNELS (8)
+
+struct ADS1256SessionConfig {
+	uint8_t pin_drdy = 4;
+	uint8_t pin_cs = 22;
+	uint8_t pin_reset = 18;
+	ADS1256ResetMode reset_mode = ADS1256ResetMode::ClockPin;
+	bool auto_calibration = true;
+	DataRate data_rate = DataRate::SPS2;
+	uint8_t n_channels = 1;
+	uint8_t muxes[ADS1256_SESSION_MAX_CHANNELS] = {
+		mux_of(0), mux_of(1), mux_of(2), mux_of(3), mux_of(4), mux_of(5), mux_of(6), mux_of(7),
+	};
+
+	inline bool valid() const {
+		return n_channels >= 1 && n_channels <= ADS1256_SESSION_MAX_CHANNELS;
+	}
+};
+
+// Called after each update() with the number of samples captured so far; returns false to end the session
+typedef bool (*ADS1256SessionCallback)(uint32_t samples, void* context);
+
+template<uint8_t nCycledChannels>
+ADS1256Error run_session(const ADS1256SessionConfig& config, ADS1256TraceRecorder* trace, ADS1256SessionCallback more, void* context) {
+	ADS1256<nCycledChannels> adc(config.pin_drdy, config.pin_cs, config.pin_reset, config.reset_mode);
+	adc.trace = trace;
+	adc.auto_calibration = config.auto_calibration;
+	adc.data_rate = config.data_rate;
+	for (uint8_t c = 0; c < nCycledChannels; c++) {
+		adc.muxes[c] = config.muxes[c];
+	}
+
+	ADS1256Error result = adc.blockingInit();
+	if (result == ADS1256Error::None) {
+		result = adc.beginCapture();
+	}
+	if (result != ADS1256Error::None) {
+		return result;
+	}
+	uint32_t samples = 0;
+	do {
+		adc.update();
+		if (adc.new_data != ADS1256_NO_NEW_DATA) {
+			adc.new_data = ADS1256_NO_NEW_DATA;
+			samples++;
+		}
+	} while (adc.state() == ADS1256State::Capturing && more(samples, context));
+	return ADS1256Error::None;
+}
+
+// config must be valid()
+inline ADS1256Error run_session(const ADS1256SessionConfig& config, ADS1256TraceRecorder* trace, ADS1256SessionCallback more, void* context) {
+	switch (config.n_channels) {
+		case 1: return run_session<1>(config, trace, more, context);
+		case 2: return run_session<2>(config, trace, more, context);
+		case 3: return run_session<3>(config, trace, more, context);
+		case 4: return run_session<4>(config, trace, more, context);
+		case 5: return run_session<5>(config, trace, more, context);
+		case 6: return run_session<6>(config, trace, more, context);
+		case 7: return run_session<7>(config, trace, more, context);
+		case 8: return run_session<8>(config, trace, more, context);
+		default: abort();
+	}
+}
+
+#endif
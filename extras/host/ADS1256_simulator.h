@@ -0,0 +1,147 @@
+#ifndef ADS1256_SIMULATOR_H
+#define ADS1256_SIMULATOR_H
+
+// HostBus that behaves like an ADS1256, so the driver can run on a host without a recording.
+//
+// Registers are written and read back with WREG/RREG and return to their power-on values on a reset (a
+// write to the reset pin, or RESET).  DRDY is driven from the virtual clock: it goes high when a conversion
+// starts (WAKEUP, SELFCAL, a settings write, the end of a reset, or reading a result while idle) and low
+// again once the settling time of the data rate has passed (see settling_time_us).  Each RDATA returns the
+// next value of a 23-bit counter, so a consumer can check that no sample was lost or repeated.
+
+#include "Arduino.h"
+#include <ADS1256_constants.h>
+
+#define ADS1256_SIMULATOR_RESET_US (1000)  // From the last write to the reset pin until DRDY falls
+#define ADS1256_SIMULATOR_COUNTER_MASK (0x7FFFFF)
+
+class ADS1256SimulatedBus : public HostBus {
+  public:
+	ADS1256SimulatedBus(uint8_t pin_drdy, uint8_t pin_cs, uint8_t pin_reset) :
+		pin_drdy_(pin_drdy), pin_cs_(pin_cs), pin_reset_(pin_reset)
+	{
+		reset();
+	}
+
+	uint32_t reads = 0;  // Results read with RDATA
+
+	inline uint8_t reg(Register r) const {
+		return regs_[(uint8_t)r];
+	}
+
+	void digitalWrite(uint8_t pin, uint8_t level) override {
+		if (pin == pin_reset_) {
+			reset();
+		} else if (pin == pin_cs_ && level == HIGH) {
+			step_ = Step::Command;
+		}
+	}
+
+	int digitalRead(uint8_t pin) override {
+		if (pin != pin_drdy_) {
+			return HIGH;
+		}
+		return host_clock_us() >= ready_at_us_ ? LOW : HIGH;
+	}
+
+	uint8_t transfer(uint8_t mosi) override {
+		uint8_t miso = 0;
+		switch (step_) {
+			case Step::Command:
+				command(mosi);
+				break;
+			case Step::Count:
+				remaining_ = (mosi & 0x0F) + 1;
+				step_ = Step::Registers;
+				break;
+			case Step::Registers:
+				if (register_ < sizeof(regs_)) {
+					if (writing_) {
+						regs_[register_] = mosi;
+					} else {
+						miso = regs_[register_];
+					}
+				}
+				register_++;
+				if (--remaining_ == 0) {
+					step_ = Step::Command;
+					if (writing_) {
+						// A new data rate or gain restarts the conversion
+						startConversion();
+					}
+				}
+				break;
+			case Step::Data:
+				miso = (uint8_t)(result_ >> (8 * --remaining_));
+				if (remaining_ == 0) {
+					step_ = Step::Command;
+				}
+				break;
+		}
+		return miso;
+	}
+
+  private:
+	enum class Step : uint8_t {
+		Command = 0,
+		Count,
+		Registers,
+		Data,
+	};
+
+	uint8_t pin_drdy_;
+	uint8_t pin_cs_;
+	uint8_t pin_reset_;
+	uint8_t regs_[11];
+	Step step_ = Step::Command;
+	bool writing_ = false;
+	uint8_t register_ = 0;
+	uint8_t remaining_ = 0;
+	uint32_t result_ = 0;
+	uint64_t ready_at_us_ = 0;
+
+	void reset() {
+		static const uint8_t POWER_ON[sizeof(regs_)] = {0x30, 0x01, 0x20, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+		memcpy(regs_, POWER_ON, sizeof(regs_));
+		step_ = Step::Command;
+		ready_at_us_ = host_clock_us() + ADS1256_SIMULATOR_RESET_US;
+	}
+
+	void startConversion() {
+		ready_at_us_ = host_clock_us() + settling_time_us((DataRate)regs_[(uint8_t)Register::DRATE]);
+	}
+
+	void command(uint8_t mosi) {
+		switch (mosi & 0xF0) {
+			case CMD_WREG:
+			case CMD_RREG:
+				writing_ = (mosi & 0xF0) == CMD_WREG;
+				register_ = mosi & 0x0F;
+				step_ = Step::Count;
+				return;
+		}
+		switch (mosi) {
+			case CMD_WAKEUP:
+			case CMD_SELFCAL:
+				startConversion();
+				break;
+			case CMD_RDATA:
+				result_ = reads++ & ADS1256_SIMULATOR_COUNTER_MASK;
+				remaining_ = 3;
+				step_ = Step::Data;
+				if (host_clock_us() >= ready_at_us_) {
+					// Continuous conversion: DRDY rises until the next result
+					startConversion();
+				}
+				break;
+			case CMD_RESET:
+				reset();
+				break;
+			default:
+				// SYNC, STANDBY, and others do not change the simulated state
+				break;
+		}
+	}
+};
+
+#endif
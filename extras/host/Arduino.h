@@ -0,0 +1,174 @@
+#ifndef ADS1256_HOST_ARDUINO_H
+#define ADS1256_HOST_ARDUINO_H
+
+// Minimal Arduino API for building ADS1256_async on a host (e.g., Linux) with -std=c++17.
+//
+// Pin and SPI activity is forwarded to the HostBus installed in host_bus().  Time is virtual: it advances
+// only through delays, by one microsecond on each call to micros()/millis() (so timeout loops always make
+// progress), by one microsecond on each digitalRead() (so polling a pin makes progress too), and wherever a
+// HostBus chooses to move it.
+
+#include <atomic>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#define ADS1256_HOST
+
+#define HIGH (1)
+#define LOW (0)
+#define INPUT (0)
+#define OUTPUT (1)
+#define INPUT_PULLUP (2)
+#define LSBFIRST (0)
+#define MSBFIRST (1)
+#define DEC (10)
+#define HEX (16)
+#define BIN (2)
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_float(addr) (*(const float*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+
+class __FlashStringHelper;
+
+inline std::atomic<uint64_t>& host_clock_us() {
+	static std::atomic<uint64_t> clock(0);
+	return clock;
+}
+
+inline void host_advance_us(uint64_t us) {
+	host_clock_us() += us;
+}
+
+// Moves the virtual clock forward to t_us (never backward)
+inline void host_advance_to_us(uint64_t t_us) {
+	uint64_t now = host_clock_us();
+	while (now < t_us && !host_clock_us().compare_exchange_weak(now, t_us)) {}
+}
+
+class HostBus {
+  public:
+	virtual ~HostBus() {}
+	virtual void pinMode(uint8_t, uint8_t) {}
+	virtual void digitalWrite(uint8_t, uint8_t) {}
+	virtual int digitalRead(uint8_t) {
+		return HIGH;
+	}
+	virtual void beginTransaction() {}
+	virtual void endTransaction() {}
+	virtual uint8_t transfer(uint8_t) {
+		return 0xFF;
+	}
+	virtual void delayMicroseconds(unsigned int us) {
+		host_advance_us(us);
+	}
+};
+
+inline HostBus*& host_bus() {
+	static HostBus default_bus;
+	static HostBus* bus = &default_bus;
+	return bus;
+}
+
+inline void pinMode(uint8_t pin, uint8_t mode) {
+	host_bus()->pinMode(pin, mode);
+}
+
+inline void digitalWrite(uint8_t pin, uint8_t level) {
+	host_bus()->digitalWrite(pin, level);
+}
+
+inline int digitalRead(uint8_t pin) {
+	host_advance_us(1);
+	return host_bus()->digitalRead(pin);
+}
+
+inline void delayMicroseconds(unsigned int us) {
+	host_bus()->delayMicroseconds(us);
+}
+
+inline void delay(unsigned long ms) {
+	host_advance_us((uint64_t)ms * 1000);
+}
+
+inline unsigned long micros() {
+	return (unsigned long)(++host_clock_us());
+}
+
+inline unsigned long millis() {
+	return (unsigned long)(++host_clock_us() / 1000);
+}
+
+inline void yield() {}
+
+class Print {
+  public:
+	virtual ~Print() {}
+	virtual size_t write(uint8_t c) {
+		return fputc(c, stdout) == EOF ? 0 : 1;
+	}
+	size_t print(const char* s) {
+		return fputs(s, stdout) == EOF ? 0 : strlen(s);
+	}
+	size_t print(const __FlashStringHelper* s) {
+		return print(reinterpret_cast<const char*>(s));
+	}
+	size_t print(char c) {
+		return write(c);
+	}
+	size_t print(long n, int base = DEC) {
+		return base == DEC ? printf("%ld", n) : print((unsigned long)n, base);
+	}
+	size_t print(unsigned long n, int base = DEC) {
+		char buffer[8 * sizeof(n) + 1];
+		char* s = buffer + sizeof(buffer) - 1;
+		*s = 0;
+		do {
+			uint8_t d = n % base;
+			*--s = d < 10 ? '0' + d : 'A' + d - 10;
+			n /= base;
+		} while (n);
+		return print(s);
+	}
+	size_t print(int n, int base = DEC) {
+		return print((long)n, base);
+	}
+	size_t print(unsigned int n, int base = DEC) {
+		return print((unsigned long)n, base);
+	}
+	size_t print(unsigned char n, int base = DEC) {
+		return print((unsigned long)n, base);
+	}
+	size_t print(double x, int digits = 2) {
+		return printf("%.*f", digits, x);
+	}
+	template<typename T>
+	size_t println(T x) {
+		size_t n = print(x);
+		return n + println();
+	}
+	template<typename T>
+	size_t println(T x, int format) {
+		size_t n = print(x, format);
+		return n + println();
+	}
+	size_t println() {
+		return print("\r\n");
+	}
+};
+
+class Stream : public Print {
+  public:
+	void begin(unsigned long) {}
+};
+
+inline Stream Serial;
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef ADS1256_HOST_SPI_H
+#define ADS1256_HOST_SPI_H
+
+// Minimal Arduino SPI API for host builds; all traffic is forwarded to host_bus()
+
+#include "Arduino.h"
+
+#define SPI_MODE0 (0)
+#define SPI_MODE1 (1)
+#define SPI_MODE2 (2)
+#define SPI_MODE3 (3)
+
+class SPISettings {
+  public:
+	SPISettings(uint32_t clock, uint8_t bit_order, uint8_t data_mode) :
+		clock(clock), bit_order(bit_order), data_mode(data_mode)
+	{}
+	SPISettings() : SPISettings(4000000, MSBFIRST, SPI_MODE0) {}
+
+	uint32_t clock;
+	uint8_t bit_order;
+	uint8_t data_mode;
+};
+
+class SPIClass {
+  public:
+	void begin() {}
+	void end() {}
+	void beginTransaction(SPISettings) {
+		host_bus()->beginTransaction();
+	}
+	void endTransaction() {
+		host_bus()->endTransaction();
+	}
+	uint8_t transfer(uint8_t data) {
+		return host_bus()->transfer(data);
+	}
+};
+
+inline SPIClass SPI;
+
+#endif
@@ -0,0 +1,93 @@
+// Records capture sessions through a simulated ADS1256 (see ADS1256_simulator.h), replays each trace
+// through the driver (see ADS1256_replay.h), and checks that the replay is identical to the recording.
+//
+// Build and run from the repository root:
+//   g++ -std=c++17 -Iextras/host -Isrc extras/host/record_replay_test.cpp -o record_replay_test
+//   ./record_replay_test
+//
+// The exit status is nonzero if any session fails to record or replay identically.
+
+#define ADS1256_TRACE
+
+#include <ADS1256_async.h>
+#include "ADS1256_replay.h"
+#include "ADS1256_session.h"
+#include "ADS1256_simulator.h"
+
+#include <vector>
+
+#define TRACE_CAPACITY (256 * 1024)
+
+struct SessionTest {
+	const char* name;
+	ADS1256SessionConfig config;
+	uint32_t samples;
+};
+
+static bool until_samples(uint32_t samples, void* context) {
+	return samples < *(const uint32_t*)context;
+}
+
+static bool run_test(const SessionTest& test) {
+	const ADS1256SessionConfig& config = test.config;
+
+	// Record
+	ADS1256SimulatedBus simulator(config.pin_drdy, config.pin_cs, config.pin_reset);
+	host_bus() = &simulator;
+	std::vector<uint8_t> recorded(TRACE_CAPACITY);
+	ADS1256TraceRecorder recorder(recorded.data(), recorded.size());
+	recorder.begin();
+	uint32_t samples = test.samples;
+	ADS1256Error result = run_session(config, &recorder, until_samples, &samples);
+	if (result != ADS1256Error::None || recorder.overflowed() || simulator.reads < test.samples) {
+		printf("%s: recording failed (error %u, %u samples read%s)\n", test.name, (unsigned)result,
+			(unsigned)simulator.reads, recorder.overflowed() ? ", trace overflowed" : "");
+		return false;
+	}
+
+	// Replay
+	ADS1256ReplayBus bus(recorder.data(), recorder.size());
+	host_bus() = &bus;
+	std::vector<uint8_t> replayed(TRACE_CAPACITY);
+	ADS1256TraceRecorder replay_recorder(replayed.data(), replayed.size());
+	replay_recorder.begin();
+	ADS1256ReplayProgress progress = {&bus};
+	result = run_session(config, &replay_recorder, ADS1256ReplayProgress::more, &progress);
+
+	bool passed = result == ADS1256Error::None && !progress.stalled && bus.finished() && bus.result.identical();
+	printf("%s: %s (%u bytes, %u operations matched, %u mismatched, %u missing, %u extra)\n",
+		test.name, passed ? "passed" : "FAILED", (unsigned)recorder.size(), (unsigned)bus.result.matched,
+		(unsigned)bus.result.mismatched, (unsigned)bus.result.missing, (unsigned)bus.result.extra);
+	host_bus() = nullptr;
+	return passed;
+}
+
+int main() {
+	SessionTest tests[3];
+
+	tests[0].name = "1 channel, 2 SPS, SCLK reset";
+	tests[0].samples = 5;
+
+	tests[1].name = "3 channels, 1000 SPS, RESET pin";
+	tests[1].config.reset_mode = ADS1256ResetMode::ControlPin;
+	tests[1].config.auto_calibration = false;
+	tests[1].config.data_rate = DataRate::SPS1000;
+	tests[1].config.n_channels = 3;
+	tests[1].samples = 300;
+
+	tests[2].name = "8 differential channels, 30000 SPS";
+	tests[2].config.data_rate = DataRate::SPS30000;
+	tests[2].config.n_channels = 8;
+	for (uint8_t c = 0; c < 8; c++) {
+		tests[2].config.muxes[c] = mux_of(c, (c + 1) & 7);
+	}
+	tests[2].samples = 1000;
+
+	uint8_t failed = 0;
+	for (const SessionTest& test : tests) {
+		if (!run_test(test)) {
+			failed++;
+		}
+	}
+	return failed ? 1 : 0;
+}
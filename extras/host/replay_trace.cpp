@@ -0,0 +1,193 @@
+// Replays a trace recorded on hardware (see ADS1256_trace.h) through the driver on a host machine and
+// reports whether the driver still produces the same SPI and pin activity.  The driver is configured from
+// the options below (defaults mirror examples/hello_ads1256); they must match the sketch that recorded the
+// trace.
+//
+// Build and run from the repository root:
+//   g++ -std=c++17 -Iextras/host -Isrc extras/host/replay_trace.cpp -o replay_trace
+//   ./replay_trace [options] session.bin [new_session.bin]
+//
+// Options:
+//   --host                  The trace was recorded on a host, where transfers take no time
+//   --drdy N, --cs N        DRDY and CS pins
+//   --reset N               RESET pin, or SCLK pin with --reset-mode clock
+//   --reset-mode pin|clock  How the ADS1256 is reset (default clock)
+//   --no-auto-calibration   STATUS ACAL bit clear
+//   --drate 0xNN            Data rate register value (default 0x03, 2 SPS)
+//   --mux 0xNN[,0xNN...]    Mux register value of each cycled channel (default 0x08, AIN0)
+//
+// The exit status is nonzero if the replayed activity differs from the recording.  If a second file
+// name is given, the activity of the replayed session is written to it as a new trace.  The SPI timing of
+// the recording is also checked against the datasheet minimums (see ADS1256_timing.h), which does not apply
+// to --host traces.
+
+#define ADS1256_TRACE
+
+#include <ADS1256_async.h>
+#include <ADS1256_timing.h>
+#include "ADS1256_replay.h"
+#include "ADS1256_session.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+static void print_summary(const char* name, const ADS1256TraceSummary& summary) {
+	printf("%s: %u SPI bytes in %u transactions, %u pin writes, %u delays totaling %u us, %u us long\n",
+		name, (unsigned)summary.spi_bytes, (unsigned)summary.transactions, (unsigned)summary.pin_writes,
+		(unsigned)summary.delays, (unsigned)summary.delay_us, (unsigned)summary.duration_us);
+}
+
+static void print_violation(const ADS1256TimingCheck& check, void*) {
+	static const char* names[] = {"t6", "t10", "t11 (short)", "t11 (long)", "t13"};
+	if (check.gap_us < check.min_us) {
+		printf("  %s violated at %u us: %.2f us < %.2f us\n",
+			names[(uint8_t)check.parameter], (unsigned)check.t_us, check.gap_us, check.min_us);
+	}
+}
+
+static bool parse_number(const char* text, uint8_t& value) {
+	char* end;
+	unsigned long n = strtoul(text, &end, 0);
+	if (*text == 0 || *end != 0 || n > 0xFF) {
+		return false;
+	}
+	value = (uint8_t)n;
+	return true;
+}
+
+static bool parse_muxes(const char* text, ADS1256SessionConfig& config) {
+	config.n_channels = 0;
+	while (config.n_channels < ADS1256_SESSION_MAX_CHANNELS) {
+		char* end;
+		unsigned long n = strtoul(text, &end, 0);
+		if (end == text || n > 0xFF || (*end != 0 && *end != ',')) {
+			return false;
+		}
+		config.muxes[config.n_channels++] = (uint8_t)n;
+		if (*end == 0) {
+			return true;
+		}
+		text = end + 1;
+	}
+	return false;
+}
+
+// Consumes the options in argv, leaving the file names; returns false if an option is not valid
+static bool parse_options(int& argc, char**& argv, ADS1256SessionConfig& config, bool& host_trace) {
+	while (argc > 1 && strncmp(argv[1], "--", 2) == 0) {
+		const char* option = argv[1];
+		const char* value = argc > 2 ? argv[2] : nullptr;
+		bool takes_value = true;
+		bool recognized = true;
+		uint8_t n;
+		bool ok;
+		if (strcmp(option, "--host") == 0) {
+			host_trace = true;
+			takes_value = false;
+			ok = true;
+		} else if (strcmp(option, "--no-auto-calibration") == 0) {
+			config.auto_calibration = false;
+			takes_value = false;
+			ok = true;
+		} else if (!value) {
+			ok = false;
+		} else if (strcmp(option, "--drdy") == 0) {
+			ok = parse_number(value, config.pin_drdy);
+		} else if (strcmp(option, "--cs") == 0) {
+			ok = parse_number(value, config.pin_cs);
+		} else if (strcmp(option, "--reset") == 0) {
+			ok = parse_number(value, config.pin_reset);
+		} else if (strcmp(option, "--reset-mode") == 0) {
+			ok = strcmp(value, "pin") == 0 || strcmp(value, "clock") == 0;
+			config.reset_mode = strcmp(value, "pin") == 0 ? ADS1256ResetMode::ControlPin : ADS1256ResetMode::ClockPin;
+		} else if (strcmp(option, "--drate") == 0) {
+			ok = parse_number(value, n) && data_rate_of_index(drate_index((DataRate)n)) == (DataRate)n;
+			config.data_rate = (DataRate)n;
+		} else if (strcmp(option, "--mux") == 0) {
+			ok = parse_muxes(value, config);
+		} else {
+			recognized = false;
+			ok = false;
+		}
+		if (!ok) {
+			fprintf(stderr, "Option %s: %s\n", option, !recognized ? "not recognized" : value ? "value not valid" : "value missing");
+			return false;
+		}
+		int consumed = takes_value ? 2 : 1;
+		argv[consumed] = argv[0];
+		argc -= consumed;
+		argv += consumed;
+	}
+	return true;
+}
+
+int main(int argc, char** argv) {
+	ADS1256SessionConfig config;
+	bool host_trace = false;
+	if (!parse_options(argc, argv, config, host_trace)) {
+		return 2;
+	}
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s [options] <trace> [output trace]\n", argv[0]);
+		return 2;
+	}
+	FILE* f = fopen(argv[1], "rb");
+	if (!f) {
+		perror(argv[1]);
+		return 2;
+	}
+	std::vector<uint8_t> recorded;
+	int c;
+	while ((c = fgetc(f)) != EOF) {
+		recorded.push_back((uint8_t)c);
+	}
+	fclose(f);
+
+	ADS1256ReplayBus bus(recorded.data(), recorded.size());
+	host_bus() = &bus;
+
+	std::vector<uint8_t> replayed(recorded.size() * 2 + 64);
+	ADS1256TraceRecorder recorder(replayed.data(), replayed.size());
+	recorder.begin();
+
+	ADS1256ReplayProgress progress = {&bus};
+	ADS1256Error result = run_session(config, &recorder, ADS1256ReplayProgress::more, &progress);
+	if (result != ADS1256Error::None) {
+		printf("Driver reported error %u during initialization\n", (unsigned)result);
+	}
+	if (progress.stalled) {
+		printf("Driver stopped following the recording at record %u\n", (unsigned)bus.position());
+	}
+
+	print_summary("Recorded", summarize_trace(recorded.data(), recorded.size()));
+	print_summary("Replayed", summarize_trace(recorder.data(), recorder.size()));
+	printf("%u operations matched, %u mismatched, %u missing, %u extra\n",
+		(unsigned)bus.result.matched, (unsigned)bus.result.mismatched,
+		(unsigned)bus.result.missing, (unsigned)bus.result.extra);
+	if (!bus.result.identical()) {
+		printf("First divergence at record %u\n", (unsigned)bus.result.first_divergence);
+	}
+
+	ADS1256TimingChecker checker(config.pin_cs, config.reset_mode == ADS1256ResetMode::ClockPin ? config.pin_reset : ADS1256_NO_PIN);
+	if (host_trace) {
+		checker.sclk_hz = 0;
+	}
+	checker.on_check = print_violation;
+	ADS1256TimingReport timing = checker.check(recorded.data(), recorded.size());
+	printf("Timing: %u gaps checked in %u transactions, %u violations (worst %.2f us), %.1f us slack, %.1f us saveable\n",
+		(unsigned)timing.checks, (unsigned)timing.transactions, (unsigned)timing.violations,
+		timing.worst_margin_us, timing.slack_us, timing.saveable_us);
+
+	if (argc > 2) {
+		f = fopen(argv[2], "wb");
+		if (!f) {
+			perror(argv[2]);
+			return 2;
+		}
+		fwrite(recorder.data(), 1, recorder.size(), f);
+		fclose(f);
+	}
+
+	return bus.result.identical() ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+// Stress-tests the lock-free block exchange of ADS1256CaptureRunner (see ADS1256_runner.h) with a real
+// acquisition thread and a consumer that stalls at random, against a simulated ADS1256 (see
+// ADS1256_simulator.h) whose results count up by one per read.
+//
+// Build and run from the repository root, preferably with ThreadSanitizer:
+//   g++ -std=c++17 -O1 -g -fsanitize=thread -Iextras/host -Isrc extras/host/runner_stress_test.cpp -o runner_stress_test
+//   ./runner_stress_test [seconds]
+//
+// Every block must arrive in sequence, and the first sample of each block must follow the last sample of
+// the previous block by exactly the number of samples dropped in between.  The exit status is nonzero if
+// either check fails or no block was dropped (the consumer never fell behind, so the test proved little).
+
+#include <ADS1256_async.h>
+#include <ADS1256_runner.h>
+#include "ADS1256_simulator.h"
+
+#include <chrono>
+#include <random>
+#include <stdlib.h>
+#include <thread>
+
+#define N_CHANNELS (3)
+#define BLOCK_SAMPLES (64)
+#define N_BLOCKS (3)
+
+const uint8_t ADC_PIN_DRDY = 4;
+const uint8_t ADC_PIN_CS = 22;
+const uint8_t ADC_PIN_RESET = 18;
+
+int main(int argc, char** argv) {
+	double seconds = argc > 1 ? atof(argv[1]) : 3;
+
+	ADS1256SimulatedBus simulator(ADC_PIN_DRDY, ADC_PIN_CS, ADC_PIN_RESET);
+	host_bus() = &simulator;
+	static ADS1256<N_CHANNELS> adc(ADC_PIN_DRDY, ADC_PIN_CS, ADC_PIN_RESET, ADS1256ResetMode::ClockPin);
+	adc.data_rate = DataRate::SPS30000;
+	for (uint8_t c = 0; c < N_CHANNELS; c++) {
+		adc.muxes[c] = mux_of(c);
+	}
+	ADS1256Error result = adc.blockingInit();
+	if (result == ADS1256Error::None) {
+		result = adc.beginCapture();
+	}
+	if (result != ADS1256Error::None) {
+		printf("Driver reported error %u during initialization\n", (unsigned)result);
+		return 1;
+	}
+	uint32_t first_read = simulator.reads;
+
+	static ADS1256CaptureRunner<N_CHANNELS, BLOCK_SAMPLES, N_BLOCKS> runner(adc);
+	runner.start();
+
+	std::mt19937 random(1256);
+	uint32_t blocks = 0;
+	uint32_t samples = 0;
+	uint32_t dropped = 0;
+	uint32_t sequence_errors = 0;
+	uint32_t value_errors = 0;
+	int32_t last = -1;
+	auto check = [&](const ADS1256CaptureRunner<N_CHANNELS, BLOCK_SAMPLES, N_BLOCKS>::Block* block) {
+		if (block->sequence != blocks) {
+			sequence_errors++;
+		}
+		blocks++;
+		dropped += block->dropped;
+		for (uint16_t i = 0; i < block->n_samples; i++) {
+			int32_t expected = last + 1 + (i == 0 ? (int32_t)block->dropped : 0);
+			if (last >= 0 && ((block->value(i) - expected) & ADS1256_SIMULATOR_COUNTER_MASK) != 0) {
+				value_errors++;
+			}
+			last = block->value(i);
+		}
+		samples += block->n_samples;
+	};
+
+	auto end = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+	while (std::chrono::steady_clock::now() < end) {
+		auto* block = runner.acquire();
+		if (!block) {
+			continue;
+		}
+		check(block);
+
+		// Fall behind now and then, so the acquisition task has to drop samples
+		if (random() % 8 == 0) {
+			std::this_thread::sleep_for(std::chrono::microseconds(random() % 2000));
+		}
+		runner.release();
+	}
+	runner.stop();
+	while (auto* block = runner.acquire()) {
+		check(block);
+		runner.release();
+	}
+
+	// Samples read from the simulator either reached a block, were dropped, or were in the discarded partial
+	// block (or the last sample, read just before the task stopped)
+	uint32_t reads = simulator.reads - first_read;
+	bool accounted = samples + runner.dropped() <= reads && reads - samples - runner.dropped() <= BLOCK_SAMPLES;
+	bool passed = sequence_errors == 0 && value_errors == 0 && accounted && dropped > 0;
+	printf("%s: %u blocks, %u samples, %u dropped (%u total), %u read, %u sequence errors, %u value errors\n",
+		passed ? "passed" : "FAILED", (unsigned)blocks, (unsigned)samples, (unsigned)dropped,
+		(unsigned)runner.dropped(), (unsigned)reads, (unsigned)sequence_errors, (unsigned)value_errors);
+	return passed ? 0 : 1;
+}
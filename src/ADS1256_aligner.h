@@ -0,0 +1,144 @@
+#ifndef ADS1256_ALIGNER_H
+#define ADS1256_ALIGNER_H
+
+// Resamples the multiplexed capture stream so every entry of muxes has a value for the same instant
+// ("virtual simultaneous sampling"), e.g. for phase or power calculations across inputs.
+//
+// Conversions are evenly spaced, so each sample is placed at the index of its conversion: with N entries in
+// muxes, entry i of scan cycle k is sampled at (k * N + i) conversion times, plus one for each sensor-detect
+// check (health_check_interval) before it, as recorded in the ADS1256's value_conversions.  Each frame is
+// aligned to the sample of the last entry (N - 1) of a cycle k.  Entry i is interpolated at that point from
+// its samples in cycles k and k + 1 (Linear) or k - 1 to k + 2 (Cubic, 4-point Lagrange), so frames are
+// emitted 1 or 2 cycles after the instant they describe.
+//
+// History is 4 samples per entry.  If samples arrive out of order (e.g. after a stall, endCapture, or
+// settings change), history is discarded and alignment restarts at the next cycle.  add(adc) adds codes at
+// adc.gain (see normalizedValue), so samples converted at other gains by auto_range are comparable; when
+// adding samples directly, use normalized codes or volts.
+
+#include "ADS1256_async.h"
+
+enum class ADS1256Interpolation : uint8_t {
+	Linear = 0,
+	Cubic,
+};
+
+template<uint8_t nCycledChannels>
+class ADS1256FrameAligner {
+  public:
+	ADS1256Interpolation interpolation = ADS1256Interpolation::Linear;
+
+	// Adds the sample indicated by adc.new_data, if any; returns true if it completed a frame.  Call once for
+	// each new sample, before new_data is cleared.
+	template<typename Sample>
+	bool add(const ADS1256<nCycledChannels, Sample>& adc) {
+		if (adc.recovering()) {
+			restart();
+			return false;
+		}
+		if (adc.new_data == ADS1256_NO_NEW_DATA) {
+			return false;
+		}
+		return add(adc.new_data, adc.normalizedValue(adc.new_data), adc.value_conversions[adc.new_data]);
+	}
+
+	// Adds a sample one conversion after the previous one
+	bool add(uint8_t channel, float value) {
+		return add(channel, value, conversion_ + 1);
+	}
+
+	// Adds a sample taken at conversion index conversion (see ADS1256::value_conversions)
+	bool add(uint8_t channel, float value, uint32_t conversion) {
+		bool started = expected_ != 0 || cycles_ != 0;
+		if (channel != expected_ || (started && (int32_t)(conversion - conversion_) <= 0)) {
+			if (started) {
+				discontinuities_++;
+			}
+			restart();
+			if (channel != 0) {
+				conversion_ = conversion;
+				return false;  // Wait for the start of a cycle
+			}
+		}
+		conversion_ = conversion;
+		history_[channel][cycles_ & 3] = value;
+		conversions_[channel][cycles_ & 3] = conversion;
+		if (++expected_ < nCycledChannels) {
+			return false;
+		}
+		expected_ = 0;
+		cycles_++;
+		uint8_t points = interpolation == ADS1256Interpolation::Cubic ? 4 : 2;
+		if (cycles_ < points) {
+			return false;
+		}
+		align(cycles_ - points);
+		return true;
+	}
+
+	// Discards history, e.g. after changing settings; the next frame is emitted once enough cycles arrive
+	void restart() {
+		expected_ = 0;
+		cycles_ = 0;
+	}
+
+	// Value of muxes[channel] at the instant of the last frame
+	inline float value(uint8_t channel) const {
+		return frame_[channel];
+	}
+
+	inline const float* frame() const {
+		return frame_;
+	}
+
+	// Scan cycle, counted from the last restart, whose last sample is the instant of the last frame
+	inline uint32_t cycle() const {
+		return cycle_;
+	}
+
+	// Number of times samples arrived out of order and history was discarded
+	inline uint32_t discontinuities() const {
+		return discontinuities_;
+	}
+
+  private:
+	float history_[nCycledChannels][4];  // Indexed by cycle modulo 4
+	uint32_t conversions_[nCycledChannels][4];  // Conversion index of each sample in history_
+	uint32_t conversion_ = 0;  // Conversion index of the last sample added
+	float frame_[nCycledChannels] = {0};
+	uint8_t expected_ = 0;
+	uint32_t cycles_ = 0;
+	uint32_t cycle_ = 0;
+	uint32_t discontinuities_ = 0;
+
+	// Interpolates history starting at cycle first, the oldest cycle used
+	void align(uint32_t first) {
+		bool cubic = interpolation == ADS1256Interpolation::Cubic;
+		uint32_t frame_cycle = cubic ? first + 1 : first;
+		uint32_t frame_conversion = conversions_[nCycledChannels - 1][frame_cycle & 3];
+		uint8_t points = cubic ? 4 : 2;
+		for (uint8_t i = 0; i < nCycledChannels; i++) {
+			// Lagrange interpolation, with times in conversions relative to the sample of cycle frame_cycle
+			uint32_t origin = conversions_[i][frame_cycle & 3];
+			float u = (float)(int32_t)(frame_conversion - origin);
+			float t[4];
+			for (uint8_t j = 0; j < points; j++) {
+				t[j] = (float)(int32_t)(conversions_[i][(first + j) & 3] - origin);
+			}
+			float value = 0;
+			for (uint8_t j = 0; j < points; j++) {
+				float weight = 1;
+				for (uint8_t m = 0; m < points; m++) {
+					if (m != j) {
+						weight *= (u - t[m]) / (t[j] - t[m]);
+					}
+				}
+				value += weight * history_[i][(first + j) & 3];
+			}
+			frame_[i] = value;
+		}
+		cycle_ = frame_cycle;
+	}
+};
+
+#endif
@@ -5,12 +5,28 @@
 #include <SPI.h>
 
 #include "ADS1256_constants.h"
+#include "ADS1256_event_log.h"
+#include "ADS1256_sample.h"
+#ifdef ADS1256_TRACE
+#include "ADS1256_trace.h"
+#endif
 
 #define ADS1256_NO_PIN (255)
 #define ADS1256_NO_MUX (255)
 #define ADS1256_NO_NEW_DATA (255)
 #define IRRELEVANT (0xFF)
-#define DEFAULT_TIMEOUT_MS (10)
+#define DEFAULT_TIMEOUT_MS (10)  // Margin added to timeouts derived from the data rate
+#define AUTO_TIMEOUT (-1)
+#define DEFAULT_WATCHDOG_PERIODS (4)
+#define DEFAULT_SETTINGS_CHECK_INTERVAL (256)
+#define DEFAULT_AUTO_RANGE_LIMIT (0x600000)
+#define DEFAULT_AUTO_RANGE_DECAY_SHIFT (8)
+#define DEFAULT_OPEN_THRESHOLD (0x7F0000)
+#define DEFAULT_SHORT_THRESHOLD (16)
+#define DEFAULT_SPI_CLOCK_HZ (1920000)
+#define DEFAULT_CAPTURE_LATENCY_US (20)
+#define CAPTURE_COMMAND_BYTES (5)  // WREG MUX (3), SYNC, WAKEUP
+#define CAPTURE_COMMAND_DELAY_US (5)  // delay_t11_short() + delay_t11_long()
 
 enum class ADS1256ResetMode : uint8_t {
 	UserManaged = 0,
@@ -25,6 +41,7 @@ enum class ADS1256State : uint8_t {
 	Idle,
 	Capturing,
 	FinishingCapture,
+	Calibrating,
 };
 
 enum class ADS1256Error : uint8_t {
@@ -40,9 +57,42 @@ enum class ADS1256Error : uint8_t {
 	CanOnlyWriteSettingsWhenIdle,
 	CanOnlyReadSettingsWhenIdle,
 	CanOnlyBeginCaptureWhenIdle,
+	NotReadyToCalibrate,
+	CanOnlyCalibrateWhenIdle,
+};
+
+enum class ADS1256SensorHealth : uint8_t {
+	Unknown = 0,  // Not checked yet (or inconclusive)
+	Ok,
+	Open,  // Current source drove the input to positive full scale
+	Short,  // Current source did not change the reading measurably
+};
+
+// Time between the starts of consecutive conversions in a capture: the settling time of the data rate
+// plus the time for continueCapture() to start the next conversion once DRDY falls (latency_us, then WREG
+// MUX and optionally ADCON, t11, SYNC, t11, and WAKEUP).  The previous result is read while it settles.
+inline float capture_conversion_us(DataRate data_rate, float sclk_hz, float latency_us, bool write_adcon) {
+	uint8_t bytes = CAPTURE_COMMAND_BYTES + (write_adcon ? 1 : 0);
+	return settling_time_us(data_rate) + latency_us + bytes * 8e6f / sclk_hz + CAPTURE_COMMAND_DELAY_US;
+}
+
+// Input voltage of a code converted at gain
+inline float volts_of(int32_t code, Gain gain, float vref = 2.5f) {
+	return code * (2 * vref / 8388607.0f) / (1 << (uint8_t)gain);
+}
+
+struct ADS1256WatchdogStats {
+	uint16_t outages = 0;  // Number of stalled or out-of-sync captures detected
+	uint16_t recovery_attempts = 0;  // Number of reset-and-rewrite attempts (more than outages if some attempts failed)
+	uint32_t last_outage_us = 0;  // Time from the last good conversion to resumed capture for the most recent outage
+	uint32_t longest_outage_us = 0;
+	uint32_t total_outage_ms = 0;
+	uint16_t total_outage_remainder_us = 0;  // Part of total outage time not yet counted in total_outage_ms
+	ADS1256Error last_error = ADS1256Error::None;  // Most recent error encountered during a recovery attempt
 };
 
-template<uint8_t nCycledChannels>
+// Sample is the storage type of values (see ADS1256_sample.h)
+template<uint8_t nCycledChannels, typename Sample = int32_t>
 class ADS1256 {
   public:
 	ADS1256(
@@ -85,7 +135,11 @@ class ADS1256 {
 	
 	// Default SPI settings may be overridden
 	// SPI_MODE1 = output edge: rising, data capture: falling; clock polarity: 0, clock phase: 1.
-	SPISettings spi_settings = SPISettings(1920000, MSBFIRST, SPI_MODE1);
+	SPISettings spi_settings = SPISettings(DEFAULT_SPI_CLOCK_HZ, MSBFIRST, SPI_MODE1);
+	
+	// Used only to estimate capture timing (see conversionUs); spi_clock_hz should match spi_settings
+	uint32_t spi_clock_hz = DEFAULT_SPI_CLOCK_HZ;
+	float capture_latency_us = DEFAULT_CAPTURE_LATENCY_US;  // From DRDY falling until update() runs continueCapture()
 	
 	bool lsb_first = false;
 	bool auto_calibration = false;
@@ -97,15 +151,98 @@ class ADS1256 {
 	
 	bool settings_out_of_sync = false;
 	
+	// When enabled, each conversion in a capture uses the highest gain at which the recent peak amplitude of
+	// that entry of muxes stays below auto_range_limit codes.  The peak decays by 1/2^auto_range_decay_shift
+	// per conversion so the gain can rise again when the signal shrinks.  Gain changes are written to ADCON
+	// in the same WREG that retargets the multiplexer.  Note that, with auto_calibration, the ADS1256
+	// self-calibrates whenever the gain changes, which lengthens that conversion.
+	bool auto_range = false;
+	int32_t auto_range_limit = DEFAULT_AUTO_RANGE_LIMIT;
+	uint8_t auto_range_decay_shift = DEFAULT_AUTO_RANGE_DECAY_SHIFT;
+	
+	// When health_check_interval is nonzero, a sensor-detect conversion is added to a capture after every
+	// health_check_interval regular conversions (costing 1 / (health_check_interval + 1) of throughput), cycling
+	// through the entries of muxes whose sensor_checks entry is not SDCS::Off.  That conversion enables the
+	// current source in the ADCON written with the multiplexer, and the next conversion disables it again.
+	// Its result is not stored in values or reported through new_data; instead sensor_health is updated:
+	// Open if the result is at least open_threshold, Short if it is within short_threshold codes of the last
+	// regular value of that entry (at the same gain), and Ok otherwise.  A check delays the samples after it
+	// by one conversion; value_conversions records where each sample falls, so consumers that need evenly
+	// spaced samples can allow for it.
+	SDCS sensor_checks[nCycledChannels] = {};
+	uint16_t health_check_interval = 0;
+	int32_t open_threshold = DEFAULT_OPEN_THRESHOLD;
+	int32_t short_threshold = DEFAULT_SHORT_THRESHOLD;
+	ADS1256SensorHealth sensor_health[nCycledChannels] = {};
+	int32_t sensor_check_values[nCycledChannels];  // Result of the last check of each entry, for tuning thresholds
+	
+	// When enabled, a capture that sees no DRDY within watchdog_periods conversion times (or that has
+	// settings_out_of_sync set) is recovered by update() without blocking: the ADS1256 is reset, settings
+	// are rewritten and verified, and capture resumes at the same position in muxes.  Since a brownout
+	// resets the ADS1256 to defaults without stopping DRDY, the watchdog also reads back the settings
+	// registers every settings_check_interval conversions (0 to never) and sets settings_out_of_sync if
+	// they do not match.
+	bool watchdog = false;
+	uint8_t watchdog_periods = DEFAULT_WATCHDOG_PERIODS;
+	uint16_t settings_check_interval = DEFAULT_SETTINGS_CHECK_INTERVAL;
+	ADS1256WatchdogStats watchdog_stats;
+	
+	// When set, state transitions, errors, and watchdog timing events are recorded to this log
+	ADS1256EventLog* event_log = nullptr;
+	
+#ifdef ADS1256_TRACE
+	// When set, all SPI and pin activity is recorded to this trace
+	ADS1256TraceRecorder* trace = nullptr;
+	
+#endif
 	uint8_t muxes[nCycledChannels];
 	uint8_t next_mux = 0;
-	int32_t values[nCycledChannels];
+	Sample values[nCycledChannels];  // Use value() unless Sample is int32_t
+	Gain value_gains[nCycledChannels];  // Gain at which each of values was converted
+	// Index of the conversion of each of values, counting every conversion (including checks) since the
+	// capture began; it restarts at 0 when the watchdog resumes a capture
+	uint32_t value_conversions[nCycledChannels];
 	uint8_t new_data = ADS1256_NO_NEW_DATA;
 	
 	inline ADS1256State state() {
 		return state_;
 	}
 	
+	inline bool recovering() const {
+		return recovery_ != RecoveryStep::None;
+	}
+	
+	// True when a conversion result is ready (DRDY is low)
+	inline bool dataReady() {
+		return readPin(pin_drdy_) == LOW;
+	}
+	
+	// Expected time between the starts of consecutive conversions while capturing, in the steady state where
+	// ADCON is not rewritten (auto_range only writes it, one byte more, on the conversions that change gain)
+	inline float conversionUs() const {
+		return capture_conversion_us(data_rate, spi_clock_hz, capture_latency_us, false);
+	}
+	
+	// Average rate at which each entry of muxes is sampled while capturing
+	inline float channelRateHz() const {
+		float rate = 1e6f / ((float)nCycledChannels * conversionUs());
+		return health_check_interval ? rate * health_check_interval / (health_check_interval + 1) : rate;
+	}
+	
+	inline uint32_t watchdogTimeoutUs() const {
+		return (uint32_t)watchdog_periods * settling_time_us(data_rate) + DEFAULT_TIMEOUT_MS * 1000UL;
+	}
+	
+	// Timeout used when AUTO_TIMEOUT is specified for waits on a single conversion
+	inline int16_t conversionTimeoutMs() const {
+		return (int16_t)((settling_time_us(data_rate) + 999) / 1000 + DEFAULT_TIMEOUT_MS);
+	}
+	
+	// Timeout used when AUTO_TIMEOUT is specified for blockingInit (reset, calibration, and verification)
+	inline int16_t initTimeoutMs() const {
+		return (int16_t)(1000 + 4 * ((settling_time_us(data_rate) + 999) / 1000));
+	}
+	
 	void setupPins();
 	
 	void update();
@@ -116,18 +253,21 @@ class ADS1256 {
 	
 	ADS1256Error beginReset();
 	
-	ADS1256Error beginWriteSettings(int16_t timeout_ms = DEFAULT_TIMEOUT_MS);
+	ADS1256Error beginWriteSettings(int16_t timeout_ms = AUTO_TIMEOUT);
 	
-	ADS1256Error readSettings(bool update_local_settings, int16_t timeout_ms = DEFAULT_TIMEOUT_MS);
+	ADS1256Error readSettings(bool update_local_settings, int16_t timeout_ms = AUTO_TIMEOUT);
 	
-	ADS1256Error blockingInit(int16_t timeout_ms = 1000);
+	ADS1256Error blockingInit(int16_t timeout_ms = AUTO_TIMEOUT);
 	
-	ADS1256Error beginCapture(int16_t timeout_ms = DEFAULT_TIMEOUT_MS);
+	ADS1256Error beginCapture(int16_t timeout_ms = AUTO_TIMEOUT);
 	
 	void continueCapture();
 	
 	ADS1256Error endCapture();
 	
+	// Self-calibrates offset and gain at the current settings; update() returns to Idle when complete
+	ADS1256Error beginSelfCalibration(int16_t timeout_ms = AUTO_TIMEOUT);
+	
 	
 	inline uint8_t getStatusRegisterValue() {
 		return (lsb_first ? STATUS_ORDER_LSB : STATUS_ORDER_MSB) |
@@ -144,7 +284,31 @@ class ADS1256 {
 			(uint8_t)sensor_detect |
 			(uint8_t)gain;
 	}
+	
+	// Sign-extended code of values[channel]
+	inline int32_t value(uint8_t channel) const {
+		return ADS1256SampleTraits<Sample>::load(values[channel]);
+	}
+	
+	// Input voltage of values[channel], accounting for the gain at which it was converted
+	inline float volts(uint8_t channel, float vref = 2.5f) const {
+		return volts_of(value(channel), value_gains[channel], vref);
+	}
+	
+	// values[channel] in codes at gain, so values converted at other gains by auto_range are comparable
+	// (exact, since gains are powers of two)
+	inline float normalizedValue(uint8_t channel) const {
+		int8_t shift = (int8_t)gain - (int8_t)value_gains[channel];
+		float v = (float)value(channel);
+		return shift >= 0 ? v * (1 << shift) : v / (1 << -shift);
+	}
   private:
+	enum class RecoveryStep : uint8_t {
+		None = 0,
+		Resetting,
+		WritingSettings,
+	};
+	
 	SPIClass& spi_;
 	ADS1256ResetMode reset_mode_;
 	
@@ -153,79 +317,276 @@ class ADS1256 {
 	uint8_t pin_reset_;
 	uint8_t pin_sync_;
 	
-	ADS1256State state_;
+	ADS1256State state_ = ADS1256State::Uninitialized;
 	
 	uint8_t current_mux_ = ADS1256_NO_MUX;
+	Gain current_gain_ = Gain::X1;
+	unsigned long conversion_started_us_ = 0;
+	uint8_t adcon_written_ = IRRELEVANT;
+	
+	Gain channel_gains_[nCycledChannels];
+	uint32_t peaks_[nCycledChannels];  // Recent peak amplitude of each channel, in codes at Gain::X64
+	
+	void updateAutoRange(uint8_t channel, int32_t value, Gain value_gain);
+	
+	bool current_check_ = false;  // Conversion of current_mux_ is a sensor-detect check
+	uint32_t current_conversion_ = 0;  // Index of the conversion of current_mux_ in this capture
+	uint32_t conversions_started_ = 0;
+	uint16_t conversions_since_check_ = 0;
+	uint16_t conversions_since_settings_check_ = 0;
+	uint8_t next_check_ = 0;
+	bool converted_[nCycledChannels];  // values[channel] has been converted during this capture
+	
+	uint8_t nextCheck();
+	void updateSensorHealth(uint8_t channel, int32_t result, Gain result_gain);
+	
+	RecoveryStep recovery_ = RecoveryStep::None;
+	bool recovery_resumes_capture_ = false;
+	unsigned long outage_started_us_ = 0;
+	unsigned long recovery_attempt_started_us_ = 0;
+	
+	void beginRecovery();
+	void beginRecoveryAttempt();
+	void continueRecovery();
+	
+	inline void setState(ADS1256State state) {
+		if (event_log && state != state_) {
+			event_log->record(ADS1256EventType::StateTransition, (uint8_t)state, (uint8_t)state_);
+		}
+		state_ = state;
+	}
+	inline ADS1256Error fail(ADS1256Error error) {
+		if (event_log) {
+			event_log->record(ADS1256EventType::Error, (uint8_t)error);
+		}
+		return error;
+	}
+	inline void logTiming(ADS1256TimingEvent event, uint32_t duration_us) {
+		if (event_log) {
+			event_log->record(ADS1256EventType::Timing, (uint8_t)event, duration_us);
+		}
+	}
+	
+	inline void writePin(uint8_t pin, uint8_t level) {
+		digitalWrite(pin, level);
+#ifdef ADS1256_TRACE
+		if (trace) {
+			trace->pinWrite(pin, level);
+		}
+#endif
+	}
+	inline int readPin(uint8_t pin) {
+		int level = digitalRead(pin);
+#ifdef ADS1256_TRACE
+		if (trace) {
+			trace->pinRead(pin, level);
+		}
+#endif
+		return level;
+	}
+	inline uint8_t transfer(uint8_t mosi) {
+		uint8_t miso = spi_.transfer(mosi);
+#ifdef ADS1256_TRACE
+		if (trace) {
+			trace->spiTransfer(mosi, miso);
+		}
+#endif
+		return miso;
+	}
+	inline void beginTransaction() {
+		spi_.beginTransaction(spi_settings);
+#ifdef ADS1256_TRACE
+		if (trace) {
+			trace->beginTransaction();
+		}
+#endif
+	}
+	inline void endTransaction() {
+		spi_.endTransaction();
+#ifdef ADS1256_TRACE
+		if (trace) {
+			trace->endTransaction();
+		}
+#endif
+	}
+	inline void delayUs(unsigned int us) {
+		delayMicroseconds(us);
+#ifdef ADS1256_TRACE
+		if (trace) {
+			trace->delay(us);
+		}
+#endif
+	}
 	
 	// Note: assumed clock frequency of 7.68 MHz for delay_* below
 	inline void delay_t6() {
-		delayMicroseconds(7); // t6: at least 50 clock periods
+		delayUs(7); // t6: at least 50 clock periods
 	}
 	inline void delay_t10() {
-		delayMicroseconds(2); // t10: at least 8 clock periods
+		delayUs(2); // t10: at least 8 clock periods
 	}
 	inline void delay_t11_short() {
-		delayMicroseconds(1);  // t11 (RREG, WREG, RDATA): at least 4 clock periods
+		delayUs(1);  // t11 (RREG, WREG, RDATA): at least 4 clock periods
 	}
 	inline void delay_t11_long() {
-		delayMicroseconds(4);  // t11 (RDATAC, SYNC): at least 24 clock periods
+		delayUs(4);  // t11 (RDATAC, SYNC): at least 24 clock periods
 	}
 	inline void delay_t12() {
-		delayMicroseconds(52);  // t12: 300-500 clock periods
+		delayUs(52);  // t12: 300-500 clock periods
 	}
 	inline void delay_t13() {
-		delayMicroseconds(1);  // t13: at least 5 clock periods
+		delayUs(1);  // t13: at least 5 clock periods
 	}
 	inline void delay_t14() {
-		delayMicroseconds(85);  // t14: 550-750 clock periods
+		delayUs(85);  // t14: 550-750 clock periods
 	}
 	inline void delay_t15() {
-		delayMicroseconds(150);  // t15: 1050-1250 clock periods
+		delayUs(150);  // t15: 1050-1250 clock periods
 	}
 };
 
 
-template<uint8_t nCycledChannels>
-void ADS1256<nCycledChannels>::setupPins() {
+template<uint8_t nCycledChannels, typename Sample>
+void ADS1256<nCycledChannels, Sample>::setupPins() {
   pinMode(pin_drdy_, INPUT_PULLUP);	
   pinMode(pin_cs_, OUTPUT);
-  digitalWrite(pin_cs_, HIGH);
+  writePin(pin_cs_, HIGH);
   if (pin_sync_ != ADS1256_NO_PIN) {
     pinMode(pin_sync_, OUTPUT);
-    digitalWrite(pin_sync_, HIGH);
+    writePin(pin_sync_, HIGH);
   }
   if (pin_reset_ != ADS1256_NO_PIN && reset_mode_ == ADS1256ResetMode::ControlPin) {
     pinMode(pin_reset_, OUTPUT);
-	digitalWrite(pin_reset_, HIGH);
+	writePin(pin_reset_, HIGH);
   }
 }
 
-template<uint8_t nCycledChannels>
-void ADS1256<nCycledChannels>::update() {
+template<uint8_t nCycledChannels, typename Sample>
+void ADS1256<nCycledChannels, Sample>::update() {
 	switch (state_) {
 		case ADS1256State::Resetting:
-			if (digitalRead(pin_drdy_) == LOW) {
-				state_ = ADS1256State::Idle;
+			if (readPin(pin_drdy_) == LOW) {
+				setState(ADS1256State::Idle);
 			}
 			break;
 		case ADS1256State::WritingSettings:
-			if (digitalRead(pin_drdy_) == LOW) {
-				state_ = ADS1256State::Idle;
+		case ADS1256State::Calibrating:
+			if (readPin(pin_drdy_) == LOW) {
+				setState(ADS1256State::Idle);
 			}
 			break;
 		case ADS1256State::Capturing:
 		case ADS1256State::FinishingCapture:
-			if (digitalRead(pin_drdy_) == LOW) {
+			if (readPin(pin_drdy_) == LOW) {
 				continueCapture();
+			} else if (watchdog && micros() - conversion_started_us_ > watchdogTimeoutUs()) {
+				// DRDY has stopped toggling (brownout, SPI glitch, ...)
+				logTiming(ADS1256TimingEvent::Stall, micros() - conversion_started_us_);
+				beginRecovery();
 			}
+			break;
 		default:
 			// Nothing to do
 			break;
 	}
+	
+	if (watchdog && settings_out_of_sync && state_ == ADS1256State::Capturing) {
+		beginRecovery();
+	}
+	if (recovery_ != RecoveryStep::None) {
+		continueRecovery();
+	}
 }
 
-template<uint8_t nCycledChannels>
-ADS1256Error ADS1256<nCycledChannels>::beginReset() {
+template<uint8_t nCycledChannels, typename Sample>
+void ADS1256<nCycledChannels, Sample>::beginRecovery() {
+	watchdog_stats.outages++;
+	outage_started_us_ = conversion_started_us_;
+	recovery_resumes_capture_ = state_ == ADS1256State::Capturing;
+	
+	// The conversion in progress was lost; resume the scan by repeating it (unless it was a check)
+	if (current_mux_ != ADS1256_NO_MUX) {
+		if (!current_check_) {
+			next_mux = current_mux_;
+		}
+		current_mux_ = ADS1256_NO_MUX;
+		current_check_ = false;
+	}
+	settings_out_of_sync = false;
+	
+	beginRecoveryAttempt();
+}
+
+template<uint8_t nCycledChannels, typename Sample>
+void ADS1256<nCycledChannels, Sample>::beginRecoveryAttempt() {
+	watchdog_stats.recovery_attempts++;
+	recovery_attempt_started_us_ = micros();
+	recovery_ = RecoveryStep::Resetting;
+	if (beginReset() == ADS1256Error::ResetMethodNotValid) {
+		// The user manages resets; the best we can do is rewrite settings
+		setState(ADS1256State::Idle);
+	}
+}
+
+template<uint8_t nCycledChannels, typename Sample>
+void ADS1256<nCycledChannels, Sample>::continueRecovery() {
+	if (micros() - recovery_attempt_started_us_ > watchdogTimeoutUs()) {
+		// The ADS1256 did not respond to this attempt; start over
+		beginRecoveryAttempt();
+		return;
+	}
+	if (state_ != ADS1256State::Idle || readPin(pin_drdy_) == HIGH) {
+		// Still waiting on the ADS1256
+		return;
+	}
+	
+	ADS1256Error result;
+	unsigned long dt;
+	switch (recovery_) {
+		case RecoveryStep::Resetting:
+			result = beginWriteSettings(0);
+			if (result != ADS1256Error::None) {
+				watchdog_stats.last_error = result;
+				beginRecoveryAttempt();
+				return;
+			}
+			recovery_ = RecoveryStep::WritingSettings;
+			break;
+		case RecoveryStep::WritingSettings:
+			result = readSettings(false, 0);
+			if (result != ADS1256Error::None) {
+				watchdog_stats.last_error = result;
+				beginRecoveryAttempt();
+				return;
+			}
+			if (recovery_resumes_capture_) {
+				result = beginCapture(0);
+				if (result != ADS1256Error::None) {
+					watchdog_stats.last_error = result;
+					beginRecoveryAttempt();
+					return;
+				}
+			}
+			recovery_ = RecoveryStep::None;
+			
+			dt = micros() - outage_started_us_;
+			logTiming(ADS1256TimingEvent::Recovered, dt);
+			watchdog_stats.last_outage_us = dt;
+			if (dt > watchdog_stats.longest_outage_us) {
+				watchdog_stats.longest_outage_us = dt;
+			}
+			dt += watchdog_stats.total_outage_remainder_us;
+			watchdog_stats.total_outage_ms += dt / 1000;
+			watchdog_stats.total_outage_remainder_us = dt % 1000;
+			break;
+		default:
+			// Nothing to do
+			break;
+	}
+}
+
+template<uint8_t nCycledChannels, typename Sample>
+ADS1256Error ADS1256<nCycledChannels, Sample>::beginReset() {
 	// Set up pins
 	pinMode(pin_drdy_, INPUT);
 	pinMode(pin_cs_, OUTPUT);
@@ -233,78 +594,82 @@ ADS1256Error ADS1256<nCycledChannels>::beginReset() {
 		pinMode(pin_reset_, OUTPUT);
 	}
 	pinMode(pin_sync_, OUTPUT);
-	digitalWrite(pin_sync_, HIGH);
-	digitalWrite(pin_cs_, HIGH);
+	writePin(pin_sync_, HIGH);
+	writePin(pin_cs_, HIGH);
 
 	if (reset_mode_ == ADS1256ResetMode::ControlPin && pin_reset_ != ADS1256_NO_PIN) {
 		// Initiate ADS1256 reset via control pin
-		digitalWrite(pin_reset_, LOW);
-		delayMicroseconds(5);
-		digitalWrite(pin_reset_, HIGH);
+		writePin(pin_reset_, LOW);
+		delayUs(5);
+		writePin(pin_reset_, HIGH);
 	} else if (reset_mode_ == ADS1256ResetMode::ClockPin && pin_reset_ != ADS1256_NO_PIN) {
 		// Initiate ADS1256 reset via SCLK signaling
 		spi_.end();  // Make sure we can control the pin (ok if begin has not yet been called)
 		uint8_t sclk = pin_reset_;
-		digitalWrite(sclk, HIGH);
+		writePin(sclk, HIGH);
 		delay_t12();
-		digitalWrite(sclk, LOW);
+		writePin(sclk, LOW);
 		delay_t13();
-		digitalWrite(sclk, HIGH);
+		writePin(sclk, HIGH);
 		delay_t14();
-		digitalWrite(sclk, LOW);
+		writePin(sclk, LOW);
 		delay_t13();
-		digitalWrite(sclk, HIGH);
+		writePin(sclk, HIGH);
 		delay_t15();
-		digitalWrite(sclk, LOW);
+		writePin(sclk, LOW);
 	} else {
-		return ADS1256Error::ResetMethodNotValid;
+		return fail(ADS1256Error::ResetMethodNotValid);
 	}
 	
 	// Begin SPI (repeated calls are ok if something else begins SPI as well)
 	spi_.begin();
 	
-	state_ = ADS1256State::Resetting;
+	adcon_written_ = IRRELEVANT;
+	setState(ADS1256State::Resetting);
 	return ADS1256Error::None;
 }
 
-template<uint8_t nCycledChannels>
-void ADS1256<nCycledChannels>::writeRegisters(Register first_register, uint8_t n_registers, const uint8_t* values) {
-  digitalWrite(pin_cs_, LOW);
-  spi_.beginTransaction(spi_settings);
-  spi_.transfer(CMD_WREG | (uint8_t)first_register);
-  spi_.transfer(n_registers - 1);
+template<uint8_t nCycledChannels, typename Sample>
+void ADS1256<nCycledChannels, Sample>::writeRegisters(Register first_register, uint8_t n_registers, const uint8_t* values) {
+  writePin(pin_cs_, LOW);
+  beginTransaction();
+  transfer(CMD_WREG | (uint8_t)first_register);
+  transfer(n_registers - 1);
   for (uint8_t r = 0; r < n_registers; r++) {
-	spi_.transfer(values[r]);
+	transfer(values[r]);
   }
-  spi_.endTransaction();
+  endTransaction();
   delay_t10();
-  digitalWrite(pin_cs_, HIGH);
+  writePin(pin_cs_, HIGH);
 }
 
-template<uint8_t nCycledChannels>
-void ADS1256<nCycledChannels>::readRegisters(Register first_register, uint8_t n_registers, uint8_t* values) {
-  digitalWrite(pin_cs_, LOW);
-  spi_.beginTransaction(spi_settings);
-  spi_.transfer(CMD_RREG | (uint8_t)first_register);
-  spi_.transfer(n_registers - 1);
+template<uint8_t nCycledChannels, typename Sample>
+void ADS1256<nCycledChannels, Sample>::readRegisters(Register first_register, uint8_t n_registers, uint8_t* values) {
+  writePin(pin_cs_, LOW);
+  beginTransaction();
+  transfer(CMD_RREG | (uint8_t)first_register);
+  transfer(n_registers - 1);
   delay_t6();
   for (uint8_t r = 0; r < n_registers; r++) {
-	values[r] = spi_.transfer(IRRELEVANT);
+	values[r] = transfer(IRRELEVANT);
   }
-  spi_.endTransaction();
+  endTransaction();
   delay_t10();
-  digitalWrite(pin_cs_, HIGH);
+  writePin(pin_cs_, HIGH);
 }
 
-template<uint8_t nCycledChannels>
-ADS1256Error ADS1256<nCycledChannels>::beginWriteSettings(int16_t timeout_ms) {
+template<uint8_t nCycledChannels, typename Sample>
+ADS1256Error ADS1256<nCycledChannels, Sample>::beginWriteSettings(int16_t timeout_ms) {
 	if (state_ != ADS1256State::Idle) {
-		return ADS1256Error::CanOnlyWriteSettingsWhenIdle;
+		return fail(ADS1256Error::CanOnlyWriteSettingsWhenIdle);
+	}
+	if (timeout_ms < 0) {
+		timeout_ms = conversionTimeoutMs();
 	}
 	unsigned long t1 = millis() + timeout_ms;
-	while (digitalRead(pin_drdy_) == HIGH) {
+	while (readPin(pin_drdy_) == HIGH) {
 		if (millis() > t1) {
-			return ADS1256Error::NotReadyToWriteSettings;
+			return fail(ADS1256Error::NotReadyToWriteSettings);
 		}
 	}
 
@@ -317,20 +682,24 @@ ADS1256Error ADS1256<nCycledChannels>::beginWriteSettings(int16_t timeout_ms) {
 		(uint8_t)data_rate,
 	};
 	writeRegisters(Register::STATUS, N_SETTINGS_REGISTERS, values);
+	adcon_written_ = values[2];
 
-	state_ = ADS1256State::WritingSettings;
+	setState(ADS1256State::WritingSettings);
 	return ADS1256Error::None;
 }
 
-template<uint8_t nCycledChannels>
-ADS1256Error ADS1256<nCycledChannels>::readSettings(bool update_local_settings, int16_t timeout_ms) {
+template<uint8_t nCycledChannels, typename Sample>
+ADS1256Error ADS1256<nCycledChannels, Sample>::readSettings(bool update_local_settings, int16_t timeout_ms) {
 		if (state_ != ADS1256State::Idle) {
-		return ADS1256Error::CanOnlyReadSettingsWhenIdle;
+		return fail(ADS1256Error::CanOnlyReadSettingsWhenIdle);
+	}
+	if (timeout_ms < 0) {
+		timeout_ms = conversionTimeoutMs();
 	}
 	unsigned long t1 = millis() + timeout_ms;
-	while (digitalRead(pin_drdy_) == HIGH) {
+	while (readPin(pin_drdy_) == HIGH) {
 		if (millis() > t1) {
-			return ADS1256Error::NotReadyToReadSettings;
+			return fail(ADS1256Error::NotReadyToReadSettings);
 		}
 	}
 
@@ -356,17 +725,22 @@ ADS1256Error ADS1256<nCycledChannels>::readSettings(bool update_local_settings,
 			(values[2] & ADCON_WRITEMASK) != getControlRegisterValue() ||
 			values[3] != (uint8_t)data_rate
 		   ) {
-			return ADS1256Error::SettingsOutOfSync;
+			settings_out_of_sync = true;
+			return fail(ADS1256Error::SettingsOutOfSync);
 		}
+		settings_out_of_sync = false;
 	}
 	
 	return ADS1256Error::None;
 }
 
-template<uint8_t nCycledChannels>
-ADS1256Error ADS1256<nCycledChannels>::blockingInit(int16_t timeout_ms) {
+template<uint8_t nCycledChannels, typename Sample>
+ADS1256Error ADS1256<nCycledChannels, Sample>::blockingInit(int16_t timeout_ms) {
 	ADS1256Error result;
 	unsigned long t0 = millis();
+	if (timeout_ms < 0) {
+		timeout_ms = initTimeoutMs();
+	}
 	
 	if (reset_mode_ != ADS1256ResetMode::UserManaged) {
 		// Reset ADS1256
@@ -377,13 +751,13 @@ ADS1256Error ADS1256<nCycledChannels>::blockingInit(int16_t timeout_ms) {
 
 		while (state_ != ADS1256State::Idle) {
 			if (millis() - t0 > timeout_ms) {
-				return ADS1256Error::TimeoutWhileResetting;
+				return fail(ADS1256Error::TimeoutWhileResetting);
 			}
 			update();
 		}
 	} else {
 		// Assume the user has taken care of resetting the ADS1256
-		state_ = ADS1256State::Idle;
+		setState(ADS1256State::Idle);
 	}
 
 	// Write settings to ADS1256
@@ -394,7 +768,7 @@ ADS1256Error ADS1256<nCycledChannels>::blockingInit(int16_t timeout_ms) {
 
 	while (state_ != ADS1256State::Idle) {
 		if (millis() - t0 > timeout_ms) {
-			return ADS1256Error::TimeoutWhileWritingSettings;
+			return fail(ADS1256Error::TimeoutWhileWritingSettings);
 		}
 		update();
 	}
@@ -408,77 +782,243 @@ ADS1256Error ADS1256<nCycledChannels>::blockingInit(int16_t timeout_ms) {
 	return ADS1256Error::None;
 }
 
-template<uint8_t nCycledChannels>
-ADS1256Error ADS1256<nCycledChannels>::beginCapture(int16_t timeout_ms) {
+template<uint8_t nCycledChannels, typename Sample>
+ADS1256Error ADS1256<nCycledChannels, Sample>::beginCapture(int16_t timeout_ms) {
 	if (state_ != ADS1256State::Idle) {
-		return ADS1256Error::CanOnlyBeginCaptureWhenIdle;
+		return fail(ADS1256Error::CanOnlyBeginCaptureWhenIdle);
+	}
+	if (timeout_ms < 0) {
+		timeout_ms = conversionTimeoutMs();
 	}
 	unsigned long t1 = millis() + timeout_ms;
-	while (digitalRead(pin_drdy_) == HIGH) {
+	while (readPin(pin_drdy_) == HIGH) {
 		if (millis() > t1) {
-			return ADS1256Error::NotReadyToBeginCapture;
+			return fail(ADS1256Error::NotReadyToBeginCapture);
 		}
 	}
-	state_ = ADS1256State::Capturing;
+	for (uint8_t c = 0; c < nCycledChannels; c++) {
+		channel_gains_[c] = gain;
+		peaks_[c] = 0;
+		converted_[c] = false;
+		if (recovery_ == RecoveryStep::None) {
+			// Kept when recovery resumes the capture, since checks of other entries may be many conversions away
+			sensor_health[c] = ADS1256SensorHealth::Unknown;
+		}
+	}
+	conversions_since_check_ = 0;
+	conversions_since_settings_check_ = 0;
+	conversions_started_ = 0;
+	setState(ADS1256State::Capturing);
 	continueCapture();
 	return ADS1256Error::None;
 }
 
-template<uint8_t nCycledChannels>
-void ADS1256<nCycledChannels>::continueCapture() {
-	digitalWrite(pin_cs_, LOW);
-	spi_.beginTransaction(spi_settings);
+template<uint8_t nCycledChannels, typename Sample>
+void ADS1256<nCycledChannels, Sample>::continueCapture() {
+	writePin(pin_cs_, LOW);
+	beginTransaction();
 	
 	uint8_t this_mux = current_mux_;
+	Gain this_gain = current_gain_;
+	bool this_check = current_check_;
+	uint32_t this_conversion = current_conversion_;
+	bool finishing = state_ == ADS1256State::FinishingCapture;
 	if (state_ == ADS1256State::Capturing) {
-		// Retarget mulitplexer and begin the next conversion
-		spi_.transfer(CMD_WREG | REG_MUX);
-		spi_.transfer(0);  // Write 1 register
-		spi_.transfer(muxes[next_mux]);
+		// Choose between the next entry of muxes and a sensor-detect check
+		uint8_t mux = next_mux;
+		current_check_ = false;
+		if (health_check_interval && conversions_since_check_ >= health_check_interval) {
+			uint8_t check = nextCheck();
+			if (check != ADS1256_NO_MUX) {
+				mux = check;
+				current_check_ = true;
+				conversions_since_check_ = 0;
+			}
+		}
+		if (!current_check_ && conversions_since_check_ < 0xFFFF) {
+			conversions_since_check_++;
+		}
+		
+		// Retarget mulitplexer (and change gain or current sources if needed) and begin the next conversion
+		current_gain_ = auto_range ? channel_gains_[mux] : gain;
+		uint8_t adcon = (getControlRegisterValue() & ~ADCON_PGA_MASK) | (uint8_t)current_gain_;
+		if (current_check_) {
+			adcon = (adcon & ~ADCON_SDCS_MASK) | (uint8_t)sensor_checks[mux];
+		}
+		// Compared regardless of auto_range, so a gain left by an earlier auto-ranged capture is replaced
+		bool write_adcon = adcon != adcon_written_;
+		transfer(CMD_WREG | REG_MUX);
+		transfer(write_adcon ? 1 : 0);  // Write 1 or 2 registers
+		transfer(muxes[mux]);
+		if (write_adcon) {
+			transfer(adcon);
+			adcon_written_ = adcon;
+		}
 		delay_t11_short();
 		
-		spi_.transfer(CMD_SYNC);
+		transfer(CMD_SYNC);
 		delay_t11_long();
 		
-		spi_.transfer(CMD_WAKEUP);
-		current_mux_ = next_mux;
-		next_mux++;
-		if (next_mux >= nCycledChannels) {
-			next_mux = 0;
+		transfer(CMD_WAKEUP);
+		conversion_started_us_ = micros();
+		current_mux_ = mux;
+		current_conversion_ = conversions_started_++;
+		if (!current_check_) {
+			next_mux++;
+			if (next_mux >= nCycledChannels) {
+				next_mux = 0;
+			}
 		}
 	} else if (state_ == ADS1256State::FinishingCapture) {
 		// Do not begin a new conversion
 		current_mux_ = ADS1256_NO_MUX;
-		state_ = ADS1256State::Idle;
+		current_check_ = false;
+		setState(ADS1256State::Idle);
 	}
 	
 	if (this_mux != ADS1256_NO_MUX) {
 		// Read the measurement from the previous converstion
-		spi_.transfer(CMD_RDATA);
+		transfer(CMD_RDATA);
 		delay_t6();
 	
-		values[this_mux] = (int32_t)spi_.transfer(IRRELEVANT) << 16;
-		values[this_mux] |= (int32_t)spi_.transfer(IRRELEVANT) << 8;
-		values[this_mux] |= spi_.transfer(IRRELEVANT);
-		if (values[this_mux] & (1 << 23)) {
-			// Extend two's complement into 32 bits (from 24)
-			values[this_mux] |= 0xFF000000;
+		uint8_t msb = transfer(IRRELEVANT);
+		uint8_t mid = transfer(IRRELEVANT);
+		uint8_t lsb = transfer(IRRELEVANT);
+		if (this_check) {
+			Sample result;
+			ADS1256SampleTraits<Sample>::store(result, msb, mid, lsb);
+			updateSensorHealth(this_mux, ADS1256SampleTraits<Sample>::load(result), this_gain);
+		} else {
+			ADS1256SampleTraits<Sample>::store(values[this_mux], msb, mid, lsb);
+			value_gains[this_mux] = this_gain;
+			value_conversions[this_mux] = this_conversion;
+			converted_[this_mux] = true;
+			if (auto_range) {
+				updateAutoRange(this_mux, value(this_mux), this_gain);
+			}
+			new_data = this_mux;
+		}
+	}
+	
+	if (finishing) {
+		// Turn off a current source left on by a check and restore the gain replaced by auto_range
+		uint8_t adcon = getControlRegisterValue();
+		if (adcon_written_ != adcon) {
+			delay_t11_short();
+			transfer(CMD_WREG | REG_ADCON);
+			transfer(0);  // Write 1 register
+			transfer(adcon);
+			adcon_written_ = adcon;
 		}
-		new_data = this_mux;
 	}
 	
-	spi_.endTransaction();
+	if (watchdog && settings_check_interval && state_ == ADS1256State::Capturing &&
+		++conversions_since_settings_check_ >= settings_check_interval) {
+		// Read back settings, e.g. to detect a brownout reset that left DRDY running
+		conversions_since_settings_check_ = 0;
+		delay_t11_short();
+		transfer(CMD_RREG | (uint8_t)Register::STATUS);
+		transfer(3);  // Read 4 registers
+		delay_t6();
+		uint8_t status = transfer(IRRELEVANT);
+		uint8_t mux = transfer(IRRELEVANT);
+		uint8_t adcon = transfer(IRRELEVANT);
+		uint8_t drate = transfer(IRRELEVANT);
+		if ((status & STATUS_WRITEMASK) != getStatusRegisterValue() ||
+			mux != muxes[current_mux_] ||
+			(adcon_written_ != IRRELEVANT && (adcon & ADCON_WRITEMASK) != adcon_written_) ||
+			drate != (uint8_t)data_rate
+		) {
+			settings_out_of_sync = true;
+			fail(ADS1256Error::SettingsOutOfSync);
+		}
+	}
+	
+	endTransaction();
 	
 	delay_t10();
-	digitalWrite(pin_cs_, HIGH);
+	writePin(pin_cs_, HIGH);
 }
 
-template<uint8_t nCycledChannels>
-ADS1256Error ADS1256<nCycledChannels>::endCapture() {
+template<uint8_t nCycledChannels, typename Sample>
+void ADS1256<nCycledChannels, Sample>::updateAutoRange(uint8_t channel, int32_t value, Gain value_gain) {
+	// Normalize amplitude to codes at the highest gain so peaks at different gains are comparable
+	uint8_t shift = (uint8_t)Gain::X64 - (uint8_t)value_gain;
+	uint32_t amplitude = (uint32_t)(value < 0 ? -(value + 1) : value) << shift;
+	if (value >= 0x7FFFFF || value <= -0x800000) {
+		// Clipped; the true amplitude is larger than measured
+		amplitude <<= 1;
+	}
+	uint32_t peak = peaks_[channel];
+	peak -= peak >> auto_range_decay_shift;
+	if (amplitude > peak) {
+		peak = amplitude;
+	}
+	peaks_[channel] = peak;
+	
+	uint8_t g = (uint8_t)Gain::X64;
+	while (g > (uint8_t)Gain::X1 && (peak >> ((uint8_t)Gain::X64 - g)) >= (uint32_t)auto_range_limit) {
+		g--;
+	}
+	channel_gains_[channel] = (Gain)g;
+}
+
+template<uint8_t nCycledChannels, typename Sample>
+uint8_t ADS1256<nCycledChannels, Sample>::nextCheck() {
+	for (uint8_t i = 0; i < nCycledChannels; i++) {
+		uint8_t c = next_check_;
+		next_check_ = next_check_ + 1 < nCycledChannels ? next_check_ + 1 : 0;
+		if (sensor_checks[c] != SDCS::Off) {
+			return c;
+		}
+	}
+	return ADS1256_NO_MUX;
+}
+
+template<uint8_t nCycledChannels, typename Sample>
+void ADS1256<nCycledChannels, Sample>::updateSensorHealth(uint8_t channel, int32_t result, Gain result_gain) {
+	sensor_check_values[channel] = result;
+	if (result >= open_threshold) {
+		sensor_health[channel] = ADS1256SensorHealth::Open;
+	} else if (converted_[channel] && value_gains[channel] == result_gain) {
+		// Rise caused by the current source through the sensor
+		int32_t rise = result - value(channel);
+		sensor_health[channel] = rise <= short_threshold && rise >= -short_threshold ? ADS1256SensorHealth::Short : ADS1256SensorHealth::Ok;
+	}
+}
+
+template<uint8_t nCycledChannels, typename Sample>
+ADS1256Error ADS1256<nCycledChannels, Sample>::endCapture() {
 	if (state_ != ADS1256State::Capturing) {
-		return ADS1256Error::CannotEndWhenNotCapturing;
+		return fail(ADS1256Error::CannotEndWhenNotCapturing);
+	}
+	setState(ADS1256State::FinishingCapture);
+	return ADS1256Error::None;
+}
+
+template<uint8_t nCycledChannels, typename Sample>
+ADS1256Error ADS1256<nCycledChannels, Sample>::beginSelfCalibration(int16_t timeout_ms) {
+	if (state_ != ADS1256State::Idle) {
+		return fail(ADS1256Error::CanOnlyCalibrateWhenIdle);
+	}
+	if (timeout_ms < 0) {
+		timeout_ms = conversionTimeoutMs();
 	}
-	state_ = ADS1256::FinishingCapture;
+	unsigned long t1 = millis() + timeout_ms;
+	while (readPin(pin_drdy_) == HIGH) {
+		if (millis() > t1) {
+			return fail(ADS1256Error::NotReadyToCalibrate);
+		}
+	}
+	
+	writePin(pin_cs_, LOW);
+	beginTransaction();
+	transfer(CMD_SELFCAL);
+	endTransaction();
+	delay_t10();
+	writePin(pin_cs_, HIGH);
+	
+	setState(ADS1256State::Calibrating);
 	return ADS1256Error::None;
 }
 
@@ -1,6 +1,8 @@
 #ifndef ADS1256_CONSTANTS_H
 #define ADS1256_CONSTANTS_H
 
+#include <Arduino.h>
+
 // Commands
 #define CMD_WAKEUP (0b00000000)
 #define CMD_RDATA (0b00000001)
@@ -192,4 +194,31 @@ enum class DataRate : uint8_t {
 	SPS2 = DRATE_2SPS,
 };
 
+// Data rate register values indexed by their upper four bits, from slowest to fastest
+const uint8_t DRATE_BY_INDEX[16] PROGMEM = {
+	DRATE_2SPS, DRATE_5SPS, DRATE_10SPS, DRATE_15SPS, DRATE_25SPS, DRATE_30SPS, DRATE_50SPS, DRATE_60SPS,
+	DRATE_100SPS, DRATE_500SPS, DRATE_1000SPS, DRATE_2000SPS, DRATE_3750SPS, DRATE_7500SPS, DRATE_15000SPS, DRATE_30000SPS,
+};
+
+// Time, in microseconds, from SYNC/WAKEUP to DRDY for a fully-settled conversion after the multiplexer is
+// switched (datasheet Table 13, 7.68 MHz clock), indexed by the upper four bits of the data rate register
+const uint32_t DRATE_SETTLING_TIME_US[16] PROGMEM = {
+	400180, 200180, 100180, 66840, 40180, 33510, 20180, 16840,
+	10180, 2180, 1180, 680, 440, 310, 250, 210,
+};
+
+constexpr uint8_t drate_index(DataRate data_rate) {
+	return (uint8_t)data_rate >> 4;
+}
+
+inline
+DataRate data_rate_of_index(uint8_t index) {
+	return (DataRate)pgm_read_byte(&DRATE_BY_INDEX[index]);
+}
+
+inline
+uint32_t settling_time_us(DataRate data_rate) {
+	return pgm_read_dword(&DRATE_SETTLING_TIME_US[drate_index(data_rate)]);
+}
+
 #endif
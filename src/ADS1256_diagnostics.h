@@ -2,196 +2,326 @@
 #define ADS1256_DIAGNOSTICS
 
 #include "ADS1256_async.h"
+#include "ADS1256_event_log.h"
 
-String name_of(ADS1256State state) {
-	switch (state) {
-		case ADS1256State::Uninitialized:
-			return "Uninitialized";
-		case ADS1256State::Resetting:
-			return "Resetting";
-		case ADS1256State::WritingSettings:
-			return "WritingSettings";
-		case ADS1256State::Idle:
-			return "Idle";
-		case ADS1256State::Capturing:
-			return "Capturing";
-		case ADS1256State::FinishingCapture:
-			return "FinishingCapture";
-		default:
-			return "unknown";
+// Names are stored in flash and returned as __FlashStringHelper pointers, which Print (and String, if
+// desired) accept directly, so describing the ADS1256 does not allocate.
+
+const char ADS1256_NAME_UNKNOWN[] PROGMEM = "unknown";
+
+inline
+const __FlashStringHelper* name_from_table(const char* const* table, uint8_t n, uint8_t i) {
+	if (i >= n) {
+		return (const __FlashStringHelper*)ADS1256_NAME_UNKNOWN;
 	}
+	return (const __FlashStringHelper*)pgm_read_ptr(&table[i]);
 }
 
-String name_of(ADS1256Error error) {
-	switch(error) {
-		case ADS1256Error::None:
-			return "None";
-		case ADS1256Error::SettingsOutOfSync:
-			return "SettingsOutOfSync";
-		case ADS1256Error::NotReadyToWriteSettings:
-			return "NotReadyToWriteSettings";
-		case ADS1256Error::NotReadyToReadSettings:
-			return "NotReadyToReadSettings";
-		case ADS1256Error::ResetMethodNotValid:
-			return "ResetMethodNotValid";
-		case ADS1256Error::TimeoutWhileResetting:
-			return "TimeoutWhileResetting";
-		case ADS1256Error::TimeoutWhileWritingSettings:
-			return "TimeoutWhileWritingSettings";
-		case ADS1256Error::NotReadyToBeginCapture:
-			return "NotReadyToBeginCapture";
-		case ADS1256Error::CannotEndWhenNotCapturing:
-			return "CannotEndWhenNotCapturing";
-		case ADS1256Error::CanOnlyWriteSettingsWhenIdle:
-			return "CanOnlyWriteSettingsWhenIdle";
-		case ADS1256Error::CanOnlyReadSettingsWhenIdle:
-			return "CanOnlyReadSettingsWhenIdle";
-		case ADS1256Error::CanOnlyBeginCaptureWhenIdle:
-			return "CanOnlyBeginCaptureWhenIdle";
-		default:
-			return "unknown";
-	}
+#define ADS1256_NAME_TABLE_SIZE(table) (sizeof(table) / sizeof(table[0]))
+
+const char ADS1256_STATE_UNINITIALIZED[] PROGMEM = "Uninitialized";
+const char ADS1256_STATE_RESETTING[] PROGMEM = "Resetting";
+const char ADS1256_STATE_WRITINGSETTINGS[] PROGMEM = "WritingSettings";
+const char ADS1256_STATE_IDLE[] PROGMEM = "Idle";
+const char ADS1256_STATE_CAPTURING[] PROGMEM = "Capturing";
+const char ADS1256_STATE_FINISHINGCAPTURE[] PROGMEM = "FinishingCapture";
+const char ADS1256_STATE_CALIBRATING[] PROGMEM = "Calibrating";
+const char* const ADS1256_STATE_NAMES[] PROGMEM = {
+	ADS1256_STATE_UNINITIALIZED,
+	ADS1256_STATE_RESETTING,
+	ADS1256_STATE_WRITINGSETTINGS,
+	ADS1256_STATE_IDLE,
+	ADS1256_STATE_CAPTURING,
+	ADS1256_STATE_FINISHINGCAPTURE,
+	ADS1256_STATE_CALIBRATING,
+};
+
+inline
+const __FlashStringHelper* name_of(ADS1256State state) {
+	return name_from_table(ADS1256_STATE_NAMES, ADS1256_NAME_TABLE_SIZE(ADS1256_STATE_NAMES), (uint8_t)state);
 }
 
-String name_of_mux(uint8_t mux) {
+const char ADS1256_ERROR_NONE[] PROGMEM = "None";
+const char ADS1256_ERROR_SETTINGSOUTOFSYNC[] PROGMEM = "SettingsOutOfSync";
+const char ADS1256_ERROR_NOTREADYTOWRITESETTINGS[] PROGMEM = "NotReadyToWriteSettings";
+const char ADS1256_ERROR_NOTREADYTOREADSETTINGS[] PROGMEM = "NotReadyToReadSettings";
+const char ADS1256_ERROR_RESETMETHODNOTVALID[] PROGMEM = "ResetMethodNotValid";
+const char ADS1256_ERROR_TIMEOUTWHILERESETTING[] PROGMEM = "TimeoutWhileResetting";
+const char ADS1256_ERROR_TIMEOUTWHILEWRITINGSETTINGS[] PROGMEM = "TimeoutWhileWritingSettings";
+const char ADS1256_ERROR_NOTREADYTOBEGINCAPTURE[] PROGMEM = "NotReadyToBeginCapture";
+const char ADS1256_ERROR_CANNOTENDWHENNOTCAPTURING[] PROGMEM = "CannotEndWhenNotCapturing";
+const char ADS1256_ERROR_CANONLYWRITESETTINGSWHENIDLE[] PROGMEM = "CanOnlyWriteSettingsWhenIdle";
+const char ADS1256_ERROR_CANONLYREADSETTINGSWHENIDLE[] PROGMEM = "CanOnlyReadSettingsWhenIdle";
+const char ADS1256_ERROR_CANONLYBEGINCAPTUREWHENIDLE[] PROGMEM = "CanOnlyBeginCaptureWhenIdle";
+const char ADS1256_ERROR_NOTREADYTOCALIBRATE[] PROGMEM = "NotReadyToCalibrate";
+const char ADS1256_ERROR_CANONLYCALIBRATEWHENIDLE[] PROGMEM = "CanOnlyCalibrateWhenIdle";
+const char* const ADS1256_ERROR_NAMES[] PROGMEM = {
+	ADS1256_ERROR_NONE,
+	ADS1256_ERROR_SETTINGSOUTOFSYNC,
+	ADS1256_ERROR_NOTREADYTOWRITESETTINGS,
+	ADS1256_ERROR_NOTREADYTOREADSETTINGS,
+	ADS1256_ERROR_RESETMETHODNOTVALID,
+	ADS1256_ERROR_TIMEOUTWHILERESETTING,
+	ADS1256_ERROR_TIMEOUTWHILEWRITINGSETTINGS,
+	ADS1256_ERROR_NOTREADYTOBEGINCAPTURE,
+	ADS1256_ERROR_CANNOTENDWHENNOTCAPTURING,
+	ADS1256_ERROR_CANONLYWRITESETTINGSWHENIDLE,
+	ADS1256_ERROR_CANONLYREADSETTINGSWHENIDLE,
+	ADS1256_ERROR_CANONLYBEGINCAPTUREWHENIDLE,
+	ADS1256_ERROR_NOTREADYTOCALIBRATE,
+	ADS1256_ERROR_CANONLYCALIBRATEWHENIDLE,
+};
+
+inline
+const __FlashStringHelper* name_of(ADS1256Error error) {
+	return name_from_table(ADS1256_ERROR_NAMES, ADS1256_NAME_TABLE_SIZE(ADS1256_ERROR_NAMES), (uint8_t)error);
+}
+
+// Prints the inputs selected by a multiplexer register value, e.g. "AIN3-AIN2"
+inline
+size_t print_mux(Print& out, uint8_t mux) {
 	uint8_t n = mux & 0b00001111;
 	uint8_t p = mux >> 4;
+	size_t written = 0;
 	if (n > MUX_AINCOM || p > MUX_AINCOM) {
-		return "unknown";
+		written += out.print((const __FlashStringHelper*)ADS1256_NAME_UNKNOWN);
+	} else if (n == MUX_AINCOM && p == MUX_AINCOM) {
+		written += out.print(F("nothing"));
 	} else if (n == MUX_AINCOM) {
-		return "AIN" + String(p);
+		written += out.print(F("AIN"));
+		written += out.print(p);
 	} else if (p == MUX_AINCOM) {
-		return "-AIN" + String(n);
-	} else if (n == MUX_AINCOM && p == MUX_AINCOM) {
-		return "nothing";
+		written += out.print(F("-AIN"));
+		written += out.print(n);
 	} else {
-		return "AIN" + String(p) + "-AIN" + String(n);
+		written += out.print(F("AIN"));
+		written += out.print(p);
+		written += out.print(F("-AIN"));
+		written += out.print(n);
 	}
+	return written;
 }
 
-String name_of(ClockOut clock_out) {
-	switch(clock_out) {
-		case ClockOut::Off:
-			return "Off";
-		case ClockOut::FClk:
-			return "FCLK";
-		case ClockOut::FClkDiv2:
-			return "FCLK/2";
-		case ClockOut::FClkDiv4:
-			return "FCLK/4";
-		default:
-			return "unknown";
+#ifndef ADS1256_HOST
+// Appends everything printed to a String
+class ADS1256StringPrint : public Print {
+  public:
+	explicit ADS1256StringPrint(String& s) : s_(s) {}
+
+	size_t write(uint8_t c) override {
+		s_ += (char)c;
+		return 1;
 	}
+
+  private:
+	String& s_;
+};
+
+// Deprecated: allocates a String on each call; use print_mux
+inline __attribute__((deprecated("use print_mux")))
+String name_of_mux(uint8_t mux) {
+	String name;
+	ADS1256StringPrint out(name);
+	print_mux(out, mux);
+	return name;
+}
+#endif
+
+const char ADS1256_CLOCKOUT_OFF[] PROGMEM = "Off";
+const char ADS1256_CLOCKOUT_FCLK[] PROGMEM = "FCLK";
+const char ADS1256_CLOCKOUT_FCLK2[] PROGMEM = "FCLK/2";
+const char ADS1256_CLOCKOUT_FCLK4[] PROGMEM = "FCLK/4";
+const char* const ADS1256_CLOCKOUT_NAMES[] PROGMEM = {  // Indexed by CLK bits of ADCON
+	ADS1256_CLOCKOUT_OFF,
+	ADS1256_CLOCKOUT_FCLK,
+	ADS1256_CLOCKOUT_FCLK2,
+	ADS1256_CLOCKOUT_FCLK4,
+};
+
+inline
+const __FlashStringHelper* name_of(ClockOut clock_out) {
+	return name_from_table(ADS1256_CLOCKOUT_NAMES, ADS1256_NAME_TABLE_SIZE(ADS1256_CLOCKOUT_NAMES), (uint8_t)clock_out >> ADCON_CLK);
 }
 
-String name_of(DataRate data_rate) {
-	switch(data_rate) {
-		case DataRate::SPS30000:
-			return "30000 samples/sec";
-		case DataRate::SPS15000:
-			return "15000 samples/sec";
-		case DataRate::SPS7500:
-			return "7500 samples/sec";
-		case DataRate::SPS3750:
-			return "3750 samples/sec";
-		case DataRate::SPS2000:
-			return "2000 samples/sec";
-		case DataRate::SPS1000:
-			return "1000 samples/sec";
-		case DataRate::SPS500:
-			return "500 samples/sec";
-		case DataRate::SPS100:
-			return "100 samples/sec";
-		case DataRate::SPS60:
-			return "60 samples/sec";
-		case DataRate::SPS50:
-			return "50 samples/sec";
-		case DataRate::SPS30:
-			return "30 samples/sec";
-		case DataRate::SPS25:
-			return "25 samples/sec";
-		case DataRate::SPS15:
-			return "15 samples/sec";
-		case DataRate::SPS10:
-			return "10 samples/sec";
-		case DataRate::SPS5:
-			return "5 samples/sec";
-		case DataRate::SPS2:
-			return "2 samples/sec";
-		default:
-			return "unknown";
+const char ADS1256_DRATE_2SPS[] PROGMEM = "2 samples/sec";
+const char ADS1256_DRATE_5SPS[] PROGMEM = "5 samples/sec";
+const char ADS1256_DRATE_10SPS[] PROGMEM = "10 samples/sec";
+const char ADS1256_DRATE_15SPS[] PROGMEM = "15 samples/sec";
+const char ADS1256_DRATE_25SPS[] PROGMEM = "25 samples/sec";
+const char ADS1256_DRATE_30SPS[] PROGMEM = "30 samples/sec";
+const char ADS1256_DRATE_50SPS[] PROGMEM = "50 samples/sec";
+const char ADS1256_DRATE_60SPS[] PROGMEM = "60 samples/sec";
+const char ADS1256_DRATE_100SPS[] PROGMEM = "100 samples/sec";
+const char ADS1256_DRATE_500SPS[] PROGMEM = "500 samples/sec";
+const char ADS1256_DRATE_1000SPS[] PROGMEM = "1000 samples/sec";
+const char ADS1256_DRATE_2000SPS[] PROGMEM = "2000 samples/sec";
+const char ADS1256_DRATE_3750SPS[] PROGMEM = "3750 samples/sec";
+const char ADS1256_DRATE_7500SPS[] PROGMEM = "7500 samples/sec";
+const char ADS1256_DRATE_15000SPS[] PROGMEM = "15000 samples/sec";
+const char ADS1256_DRATE_30000SPS[] PROGMEM = "30000 samples/sec";
+const char* const ADS1256_DRATE_NAMES[] PROGMEM = {  // Indexed by upper four bits of DRATE
+	ADS1256_DRATE_2SPS,
+	ADS1256_DRATE_5SPS,
+	ADS1256_DRATE_10SPS,
+	ADS1256_DRATE_15SPS,
+	ADS1256_DRATE_25SPS,
+	ADS1256_DRATE_30SPS,
+	ADS1256_DRATE_50SPS,
+	ADS1256_DRATE_60SPS,
+	ADS1256_DRATE_100SPS,
+	ADS1256_DRATE_500SPS,
+	ADS1256_DRATE_1000SPS,
+	ADS1256_DRATE_2000SPS,
+	ADS1256_DRATE_3750SPS,
+	ADS1256_DRATE_7500SPS,
+	ADS1256_DRATE_15000SPS,
+	ADS1256_DRATE_30000SPS,
+};
+
+inline
+const __FlashStringHelper* name_of(DataRate data_rate) {
+	// Only the listed register values are rates; others (e.g. read from a corrupted register) are unknown
+	if (data_rate_of_index(drate_index(data_rate)) != data_rate) {
+		return (const __FlashStringHelper*)ADS1256_NAME_UNKNOWN;
 	}
+	return name_from_table(ADS1256_DRATE_NAMES, ADS1256_NAME_TABLE_SIZE(ADS1256_DRATE_NAMES), drate_index(data_rate));
 }
 
-String name_of(Gain gain) {
-	switch(gain) {
-		case Gain::X1:
-			return "1x";
-		case Gain::X2:
-			return "2x";
-		case Gain::X4:
-			return "4x";
-		case Gain::X8:
-			return "8x";
-		case Gain::X16:
-			return "16x";
-		case Gain::X32:
-			return "32x";
-		case Gain::X64:
-			return "64x";
-		default:
-			return "unknown";
-	}
+const char ADS1256_GAIN_1X[] PROGMEM = "1x";
+const char ADS1256_GAIN_2X[] PROGMEM = "2x";
+const char ADS1256_GAIN_4X[] PROGMEM = "4x";
+const char ADS1256_GAIN_8X[] PROGMEM = "8x";
+const char ADS1256_GAIN_16X[] PROGMEM = "16x";
+const char ADS1256_GAIN_32X[] PROGMEM = "32x";
+const char ADS1256_GAIN_64X[] PROGMEM = "64x";
+const char* const ADS1256_GAIN_NAMES[] PROGMEM = {
+	ADS1256_GAIN_1X,
+	ADS1256_GAIN_2X,
+	ADS1256_GAIN_4X,
+	ADS1256_GAIN_8X,
+	ADS1256_GAIN_16X,
+	ADS1256_GAIN_32X,
+	ADS1256_GAIN_64X,
+};
+
+inline
+const __FlashStringHelper* name_of(Gain gain) {
+	return name_from_table(ADS1256_GAIN_NAMES, ADS1256_NAME_TABLE_SIZE(ADS1256_GAIN_NAMES), (uint8_t)gain);
+}
+
+const char ADS1256_SDCS_OFF[] PROGMEM = "Off";
+const char ADS1256_SDCS_05UA[] PROGMEM = "0.5 uA";
+const char ADS1256_SDCS_2UA[] PROGMEM = "2 uA";
+const char ADS1256_SDCS_10UA[] PROGMEM = "10 uA";
+const char* const ADS1256_SDCS_NAMES[] PROGMEM = {  // Indexed by SDCS bits of ADCON
+	ADS1256_SDCS_OFF,
+	ADS1256_SDCS_05UA,
+	ADS1256_SDCS_2UA,
+	ADS1256_SDCS_10UA,
+};
+
+inline
+const __FlashStringHelper* name_of(SDCS sdcs) {
+	return name_from_table(ADS1256_SDCS_NAMES, ADS1256_NAME_TABLE_SIZE(ADS1256_SDCS_NAMES), (uint8_t)sdcs >> ADCON_SDCS);
+}
+
+const char ADS1256_TIMING_STALL[] PROGMEM = "Stall";
+const char ADS1256_TIMING_RECOVERED[] PROGMEM = "Recovered";
+const char* const ADS1256_TIMING_NAMES[] PROGMEM = {
+	ADS1256_TIMING_STALL,
+	ADS1256_TIMING_RECOVERED,
+};
+
+inline
+const __FlashStringHelper* name_of(ADS1256TimingEvent event) {
+	return name_from_table(ADS1256_TIMING_NAMES, ADS1256_NAME_TABLE_SIZE(ADS1256_TIMING_NAMES), (uint8_t)event);
 }
 
-String name_of(SDCS sdcs) {
-	switch(sdcs) {
-		case SDCS::Off:
-			return "Off";
-		case SDCS::SDC05uA:
-			return "0.5 uA";
-		case SDCS::SDC2uA:
-			return "2 uA";
-		case SDCS::SDC10uA:
-			return "10 uA";
-		default:
-			return "unknown";
+const char ADS1256_HEALTH_UNKNOWN[] PROGMEM = "Unknown";
+const char ADS1256_HEALTH_OK[] PROGMEM = "Ok";
+const char ADS1256_HEALTH_OPEN[] PROGMEM = "Open";
+const char ADS1256_HEALTH_SHORT[] PROGMEM = "Short";
+const char* const ADS1256_HEALTH_NAMES[] PROGMEM = {
+	ADS1256_HEALTH_UNKNOWN,
+	ADS1256_HEALTH_OK,
+	ADS1256_HEALTH_OPEN,
+	ADS1256_HEALTH_SHORT,
+};
+
+inline
+const __FlashStringHelper* name_of(ADS1256SensorHealth health) {
+	return name_from_table(ADS1256_HEALTH_NAMES, ADS1256_NAME_TABLE_SIZE(ADS1256_HEALTH_NAMES), (uint8_t)health);
+}
+
+// Prints one line per event, oldest first, e.g. "  1234567us Capturing -> Idle"
+inline
+void print_event_log(const ADS1256EventLog& log, Print& out) {
+	if (log.overwritten()) {
+		out.print(F("  ("));
+		out.print(log.overwritten());
+		out.println(F(" earlier events overwritten)"));
+	}
+	for (uint8_t i = 0; i < log.size(); i++) {
+		const ADS1256Event& event = log.at(i);
+		out.print(F("  "));
+		out.print(event.t_us);
+		out.print(F("us "));
+		switch (event.type) {
+			case ADS1256EventType::StateTransition:
+				out.print(name_of((ADS1256State)event.value));
+				out.print(F(" -> "));
+				out.println(name_of((ADS1256State)event.code));
+				break;
+			case ADS1256EventType::Error:
+				out.print(F("Error "));
+				out.println(name_of((ADS1256Error)event.code));
+				break;
+			case ADS1256EventType::Timing:
+				out.print(name_of((ADS1256TimingEvent)event.code));
+				out.print(F(" after "));
+				out.print(event.value);
+				out.println(F("us"));
+				break;
+			default:
+				out.println((const __FlashStringHelper*)ADS1256_NAME_UNKNOWN);
+				break;
+		}
 	}
 }
 
-template<uint8_t nCycledChannels>
-void print_configuration(ADS1256<nCycledChannels>& adc, Stream& serial) {
-  serial.print("  Auto calibration ");
-  serial.println(adc.auto_calibration ? "enabled" : "disabled");
-  serial.print("  Analog input buffer ");
-  serial.println(adc.buffer ? "enabled" : "disabled");
-  serial.print("  Clock output: ");
+template<uint8_t nCycledChannels, typename Sample>
+void print_configuration(ADS1256<nCycledChannels, Sample>& adc, Stream& serial) {
+  serial.print(F("  Auto calibration "));
+  serial.println(adc.auto_calibration ? F("enabled") : F("disabled"));
+  serial.print(F("  Analog input buffer "));
+  serial.println(adc.buffer ? F("enabled") : F("disabled"));
+  serial.print(F("  Clock output: "));
   serial.println(name_of(adc.clock_out));
-  serial.print("  Data rate: ");
+  serial.print(F("  Data rate: "));
   serial.println(name_of(adc.data_rate));
-  serial.print("  Gain: ");
+  serial.print(F("  Gain: "));
   serial.println(name_of(adc.gain));
-  serial.print(adc.lsb_first ? "  Least" : "  Most");
-  serial.println(" significant bit first");
-  serial.print("  Sensor detect current sources: ");
+  serial.print(adc.lsb_first ? F("  Least") : F("  Most"));
+  serial.println(F(" significant bit first"));
+  serial.print(F("  Sensor detect current sources: "));
   serial.println(name_of(adc.sensor_detect));
 }
 
-template<uint8_t nCycledChannels>
-void print_configuration(ADS1256<nCycledChannels>& adc) {
+template<uint8_t nCycledChannels, typename Sample>
+void print_configuration(ADS1256<nCycledChannels, Sample>& adc) {
 	print_configuration(adc, Serial);
 }
 
-template<uint8_t nCycledChannels>
-bool verbose_init(ADS1256<nCycledChannels>& adc, Stream& serial, unsigned long print_period_ms = 1000) {
-  serial.println("Initializing ADS1256...");
+template<uint8_t nCycledChannels, typename Sample>
+bool verbose_init(ADS1256<nCycledChannels, Sample>& adc, Stream& serial, unsigned long print_period_ms = 1000) {
+  serial.println(F("Initializing ADS1256..."));
   unsigned long last_print = millis();
 
   // Begin asynchronous reset
   unsigned long t0 = micros();
   ADS1256Error result = adc.beginReset();
   if (result != ADS1256Error::None) {
-    serial.print("Unable to begin ADS1256 reset: ");
+    serial.print(F("Unable to begin ADS1256 reset: "));
     serial.println(name_of(result));
     return false;
   }
@@ -199,33 +329,33 @@ bool verbose_init(ADS1256<nCycledChannels>& adc, Stream& serial, unsigned long p
   // Wait for reset to complete
   while (adc.state() != ADS1256State::Idle) {
     if (millis() > last_print + print_period_ms) {
-      serial.print("  Still resetting ADS1256 (");
+      serial.print(F("  Still resetting ADS1256 ("));
       serial.print(name_of(adc.state()));
-      serial.println(")...");
+      serial.println(F(")..."));
       last_print = millis();
     }
     adc.update();
   }
   unsigned long dt = micros() - t0;
-  serial.print("  Complete in ");
+  serial.print(F("  Complete in "));
   serial.print(dt);
-  serial.println("us");
+  serial.println(F("us"));
 
   // Write our desired settings
-  serial.println("Writing ADS1256 settings...");
-  serial.print("  Register values to write: STATUS=0b");
+  serial.println(F("Writing ADS1256 settings..."));
+  serial.print(F("  Register values to write: STATUS=0b"));
   serial.print(adc.getStatusRegisterValue(), BIN);
-  serial.print(", MUX=0x");
+  serial.print(F(", MUX=0x"));
   serial.print(adc.getMuxRegisterValue(), HEX);
-  serial.print(", ADCON=0b");
+  serial.print(F(", ADCON=0b"));
   serial.print(adc.getControlRegisterValue(), BIN);
-  serial.print(", DRATE=0x");
+  serial.print(F(", DRATE=0x"));
   serial.println((uint8_t)adc.data_rate, HEX);
   last_print = millis();
   t0 = micros();
   result = adc.beginWriteSettings();
   if (result != ADS1256Error::None) {
-    serial.print("Unable to begin writing ADS1256 settings: ");
+    serial.print(F("Unable to begin writing ADS1256 settings: "));
     serial.println(name_of(result));
     return false;
   }
@@ -233,38 +363,38 @@ bool verbose_init(ADS1256<nCycledChannels>& adc, Stream& serial, unsigned long p
   // Wait for settings-write to complete (includes auto calibration)
   while (adc.state() != ADS1256State::Idle) {
     if (millis() > last_print + 1000) {
-      serial.print("  Still writing ADS1256 settings(");
+      serial.print(F("  Still writing ADS1256 settings("));
       serial.print(name_of(adc.state()));
-      serial.println(")...");
+      serial.println(F(")..."));
       last_print = millis();
     }
     adc.update();
   }
   dt = micros() - t0;
-  serial.print("  Complete in ");
+  serial.print(F("  Complete in "));
   serial.print(dt);
-  serial.println("us");
+  serial.println(F("us"));
 
   // Verify that the settings were written correctly by reading them back
   result = adc.readSettings(false);
   if (result != ADS1256Error::None) {
-    serial.print("Unable to verify ADS1256 settings: ");
+    serial.print(F("Unable to verify ADS1256 settings: "));
     serial.println(name_of(result));
     uint8_t register_values[4];
     adc.readRegisters(Register::STATUS, 4, register_values);
-    serial.print("  Register values read: STATUS=0b");
+    serial.print(F("  Register values read: STATUS=0b"));
     serial.print(register_values[0], BIN);
-    serial.print(" MUX=0x");
+    serial.print(F(" MUX=0x"));
     serial.print(register_values[1], HEX);
-    serial.print(" ADCON=0b");
+    serial.print(F(" ADCON=0b"));
     serial.print(register_values[2], BIN);
-    serial.print(" DRATE=0x");
+    serial.print(F(" DRATE=0x"));
     serial.println(register_values[3], HEX);
     return false;
   }
 
-  serial.println("Initialized with configuration:");
-  print_configuration(adc);
+  serial.println(F("Initialized with configuration:"));
+  print_configuration(adc, serial);
   
   return true;
 }
@@ -0,0 +1,79 @@
+#ifndef ADS1256_EVENT_LOG_H
+#define ADS1256_EVENT_LOG_H
+
+// Fixed-size binary log of ADS1256 state transitions, errors, and timing events.  Recording an event
+// stores a few bytes in a caller-provided ring buffer; the oldest events are overwritten when it fills.
+// Use print_event_log (ADS1256_diagnostics.h) to dump the log in readable form.
+
+#include <Arduino.h>
+
+enum class ADS1256EventType : uint8_t {
+	StateTransition = 0,  // code: new ADS1256State, value: previous ADS1256State
+	Error,  // code: ADS1256Error
+	Timing,  // code: ADS1256TimingEvent, value: duration in microseconds
+};
+
+enum class ADS1256TimingEvent : uint8_t {
+	Stall = 0,  // DRDY did not arrive; value is the time since the conversion began
+	Recovered,  // Capture resumed after a stall; value is the length of the outage
+};
+
+// 10 bytes on AVR; 12 on 32-bit targets, where it is padded to a multiple of 4
+struct ADS1256Event {
+	uint32_t t_us;
+	uint32_t value;
+	ADS1256EventType type;
+	uint8_t code;
+};
+
+class ADS1256EventLog {
+  public:
+	ADS1256EventLog(ADS1256Event* buffer, uint8_t capacity) : buffer_(buffer), capacity_(capacity) {}
+
+	void record(ADS1256EventType type, uint8_t code, uint32_t value = 0) {
+		if (capacity_ == 0) {
+			overwritten_++;  // Nowhere to store events
+			return;
+		}
+		ADS1256Event& event = buffer_[(first_ + size_) % capacity_];
+		event.t_us = micros();
+		event.value = value;
+		event.type = type;
+		event.code = code;
+		if (size_ < capacity_) {
+			size_++;
+		} else {
+			first_ = (first_ + 1) % capacity_;
+			overwritten_++;
+		}
+	}
+
+	inline uint8_t size() const {
+		return size_;
+	}
+
+	// Event i, where 0 is the oldest event in the log
+	inline const ADS1256Event& at(uint8_t i) const {
+		return buffer_[(first_ + i) % capacity_];
+	}
+
+	// Number of events lost because the log was full
+	inline uint16_t overwritten() const {
+		return overwritten_;
+	}
+
+	void clear() {
+		first_ = 0;
+		size_ = 0;
+		overwritten_ = 0;
+	}
+
+  private:
+	ADS1256Event* buffer_;
+	uint8_t capacity_;
+	uint8_t first_ = 0;
+	uint8_t size_ = 0;
+	uint16_t overwritten_ = 0;
+};
+
+#endif
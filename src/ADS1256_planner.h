@@ -0,0 +1,195 @@
+#ifndef ADS1256_PLANNER_H
+#define ADS1256_PLANNER_H
+
+// Plans a capture scan before deployment: given the rate each input must be sampled at, chooses how many
+// entries of muxes (slots) each input gets, the order of the slots, and the data rate.
+//
+// Conversion times come from the same model the ADS1256 uses for channelRateHz (see conversionUs): the
+// settling time of the data rate plus the overhead of continueCapture() starting each conversion, less the
+// share of conversions taken by sensor-detect checks (health_check_interval).  Use configure(adc) to take
+// the SPI clock, latency, and check interval from an ADS1256.
+//
+// Slots are allotted greedily to the input furthest below its required rate (maximizing the minimum ratio
+// of achieved to required rate), and interleaved so repeated inputs are evenly spaced in the scan.
+
+#include "ADS1256_async.h"
+#include "ADS1256_diagnostics.h"
+
+template<uint8_t nCycledChannels>
+class ADS1256ScanPlanner {
+  public:
+	float sclk_hz = DEFAULT_SPI_CLOCK_HZ;  // Should match spi_settings
+	float latency_us = DEFAULT_CAPTURE_LATENCY_US;  // From DRDY falling until continueCapture() runs
+	uint16_t health_check_interval = 0;  // As on the ADS1256
+	bool prefer_low_noise = false;  // Choose the slowest feasible data rate instead of the fastest
+
+	// Takes the timing model parameters from adc
+	template<typename Sample>
+	void configure(const ADS1256<nCycledChannels, Sample>& adc) {
+		sclk_hz = adc.spi_clock_hz;
+		latency_us = adc.capture_latency_us;
+		health_check_interval = adc.health_check_interval;
+	}
+
+	// Time between the starts of consecutive conversions in a capture at data_rate
+	float conversionUs(DataRate data_rate) const {
+		return capture_conversion_us(data_rate, sclk_hz, latency_us, false);
+	}
+
+	// Plans a scan of n_channels inputs, where input c must be sampled at required_hz[c] (0 if it only needs
+	// to be sampled).  Returns true if every rate can be met; false if not, or if n_channels is 0 or more
+	// than nCycledChannels (every input needs at least one entry of muxes).
+	bool plan(const float* required_hz, uint8_t n_channels) {
+		feasible_ = false;
+		if (n_channels == 0 || n_channels > nCycledChannels) {
+			n_channels_ = 0;
+			return false;
+		}
+		n_channels_ = n_channels;
+
+		// Every input gets one slot, then each remaining slot goes to the input with the lowest ratio of
+		// slots to required rate (inputs with no required rate only get slots when all are in that state)
+		for (uint8_t c = 0; c < n_channels_; c++) {
+			n_slots_[c] = 1;
+			required_hz_[c] = required_hz[c] > 0 ? required_hz[c] : 0;
+		}
+		for (uint8_t s = n_channels_; s < nCycledChannels; s++) {
+			uint8_t best = 0;
+			for (uint8_t c = 1; c < n_channels_; c++) {
+				if (lessServed(c, best)) {
+					best = c;
+				}
+			}
+			n_slots_[best]++;
+		}
+
+		// Smooth weighted round-robin order, so an input with k slots recurs every nCycledChannels / k slots
+		int16_t credit[nCycledChannels] = {0};
+		for (uint8_t s = 0; s < nCycledChannels; s++) {
+			uint8_t best = 0;
+			for (uint8_t c = 0; c < n_channels_; c++) {
+				credit[c] += n_slots_[c];
+				if (credit[c] > credit[best]) {
+					best = c;
+				}
+			}
+			credit[best] -= nCycledChannels;
+			slots_[s] = best;
+		}
+
+		// Data rates in order of preference (index 0 is slowest)
+		for (uint8_t i = 0; i < 16; i++) {
+			DataRate data_rate = data_rate_of_index(prefer_low_noise ? i : 15 - i);
+			if (meets(data_rate)) {
+				data_rate_ = data_rate;
+				feasible_ = true;
+				break;
+			}
+		}
+		if (!feasible_) {
+			data_rate_ = DataRate::SPS30000;  // Report the best that can be achieved
+		}
+		return feasible_;
+	}
+
+	inline bool feasible() const {
+		return feasible_;
+	}
+
+	inline DataRate dataRate() const {
+		return data_rate_;
+	}
+
+	inline uint8_t channels() const {
+		return n_channels_;
+	}
+
+	// Input sampled by entry slot of muxes
+	inline uint8_t slot(uint8_t slot) const {
+		return slots_[slot];
+	}
+
+	inline uint8_t slotsOf(uint8_t channel) const {
+		return n_slots_[channel];
+	}
+
+	// Rate at which the whole scan repeats at data_rate
+	float scanHz(DataRate data_rate) const {
+		float rate = 1e6f / (nCycledChannels * conversionUs(data_rate));
+		return health_check_interval ? rate * health_check_interval / (health_check_interval + 1) : rate;
+	}
+
+	// Expected rate at which input channel is sampled
+	float channelRateHz(uint8_t channel) const {
+		return n_slots_[channel] * scanHz(data_rate_);
+	}
+
+	// Copies the plan to adc, where channel_muxes[c] is the mux value of input c (see mux_of)
+	template<typename Sample>
+	void apply(ADS1256<nCycledChannels, Sample>& adc, const uint8_t* channel_muxes) const {
+		for (uint8_t s = 0; s < nCycledChannels; s++) {
+			adc.muxes[s] = channel_muxes[slots_[s]];
+		}
+		adc.data_rate = data_rate_;
+	}
+
+	void print(Print& serial) const {
+		serial.print(F("Scan plan: "));
+		serial.print(feasible_ ? F("feasible") : F("NOT feasible"));
+		serial.print(F(" at "));
+		serial.print(name_of(data_rate_));
+		serial.print(F(", "));
+		serial.print(conversionUs(data_rate_));
+		serial.println(F(" us per conversion"));
+		for (uint8_t c = 0; c < n_channels_; c++) {
+			serial.print(F("  Input "));
+			serial.print(c);
+			serial.print(F(": "));
+			serial.print(n_slots_[c]);
+			serial.print(F(" slot(s), "));
+			serial.print(channelRateHz(c));
+			serial.print(F(" Hz (required "));
+			serial.print(required_hz_[c]);
+			serial.println(F(" Hz)"));
+		}
+		serial.print(F("  Order:"));
+		for (uint8_t s = 0; s < nCycledChannels; s++) {
+			serial.print(' ');
+			serial.print(slots_[s]);
+		}
+		serial.println();
+	}
+
+  private:
+	uint8_t n_channels_ = 0;
+	float required_hz_[nCycledChannels] = {0};
+	uint8_t n_slots_[nCycledChannels] = {0};
+	uint8_t slots_[nCycledChannels] = {0};
+	DataRate data_rate_ = DataRate::SPS30000;
+	bool feasible_ = false;
+
+	// True if input a is further below its required rate than input b
+	bool lessServed(uint8_t a, uint8_t b) const {
+		bool a_required = required_hz_[a] > 0;
+		bool b_required = required_hz_[b] > 0;
+		if (a_required != b_required) {
+			return a_required;
+		}
+		if (!a_required) {
+			return n_slots_[a] < n_slots_[b];
+		}
+		return n_slots_[a] * required_hz_[b] < n_slots_[b] * required_hz_[a];
+	}
+
+	bool meets(DataRate data_rate) const {
+		float scan_hz = scanHz(data_rate);
+		for (uint8_t c = 0; c < n_channels_; c++) {
+			if (n_slots_[c] * scan_hz < required_hz_[c]) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+#endif
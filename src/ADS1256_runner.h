@@ -0,0 +1,243 @@
+#ifndef ADS1256_RUNNER_H
+#define ADS1256_RUNNER_H
+
+// Runs the update()/continueCapture() loop of an ADS1256 in its own task (FreeRTOS on ESP32, std::thread on
+// host builds) and hands blocks of samples to a consumer running elsewhere (e.g., the other ESP32 core).
+//
+// Blocks are exchanged through a single-producer/single-consumer ring of nBlocks buffers using two atomic
+// counters: the acquisition task publishes a block by incrementing published_ and the consumer returns it by
+// incrementing released_.  When the consumer falls behind and every block is in use, samples are dropped
+// and the number dropped is reported with the next block that is published.
+//
+// Without auto_range every sample of a capture has the same gain, so a block stores it once; set
+// perSampleGains to store the gain of each sample (one byte per sample) when capturing with auto_range.
+
+#include <atomic>
+
+#include "ADS1256_async.h"
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+class ADS1256Task {
+  public:
+	bool start(void (*fn)(void*), void* arg, uint8_t core, uint32_t stack_bytes = 4096, uint8_t priority = 5) {
+		fn_ = fn;
+		arg_ = arg;
+		finished_ = false;
+		return xTaskCreatePinnedToCore(trampoline, "ADS1256", stack_bytes, this, priority, &handle_, core) == pdPASS;
+	}
+
+	// Waits for fn to return
+	void join() {
+		while (!finished_) {
+			vTaskDelay(1);
+		}
+	}
+
+	// Lets lower-priority tasks (including the idle task watched by the task watchdog) run briefly
+	static void pause() {
+		vTaskDelay(1);
+	}
+
+  private:
+	void (*fn_)(void*);
+	void* arg_;
+	TaskHandle_t handle_ = nullptr;
+	std::atomic<bool> finished_{true};
+
+	static void trampoline(void* self) {
+		ADS1256Task* task = (ADS1256Task*)self;
+		task->fn_(task->arg_);
+		task->finished_ = true;
+		vTaskDelete(nullptr);
+	}
+};
+
+#elif defined(ADS1256_HOST)
+#include <thread>
+
+class ADS1256Task {
+  public:
+	bool start(void (*fn)(void*), void* arg, uint8_t, uint32_t = 0, uint8_t = 0) {
+		thread_ = std::thread(fn, arg);
+		return true;
+	}
+
+	void join() {
+		if (thread_.joinable()) {
+			thread_.join();
+		}
+	}
+
+	static void pause() {
+		std::this_thread::yield();
+	}
+
+  private:
+	std::thread thread_;
+};
+
+#else
+#error "ADS1256_runner.h requires ESP32 (FreeRTOS) or a host build"
+#endif
+
+// Gains of the samples in a block
+template<uint16_t nBlockSamples, bool perSampleGains>
+struct ADS1256BlockGains {
+	Gain gains[nBlockSamples];  // Gain at which each sample was converted (varies with auto_range)
+
+	inline Gain gain(uint16_t i) const {
+		return gains[i];
+	}
+	inline void setGain(uint16_t i, Gain gain) {
+		gains[i] = gain;
+	}
+};
+
+template<uint16_t nBlockSamples>
+struct ADS1256BlockGains<nBlockSamples, false> {
+	Gain block_gain;  // Gain at which every sample was converted
+
+	inline Gain gain(uint16_t) const {
+		return block_gain;
+	}
+	inline void setGain(uint16_t, Gain gain) {
+		block_gain = gain;
+	}
+};
+
+// Sample is the storage type of block values, which should match the ADS1256 (see ADS1256_sample.h)
+template<uint8_t nCycledChannels, uint16_t nBlockSamples, uint8_t nBlocks = 3, typename Sample = int32_t, bool perSampleGains = false>
+class ADS1256CaptureRunner {
+	static_assert(nBlocks >= 2, "At least two blocks are needed to capture while the consumer processes");
+
+  public:
+	struct Block : ADS1256BlockGains<nBlockSamples, perSampleGains> {
+		uint32_t sequence;  // Increments by one for each block published
+		uint32_t dropped;  // Samples dropped immediately before this block because no block was free
+		uint16_t n_samples;
+		uint8_t channels[nBlockSamples];  // Index into muxes of each sample
+		Sample values[nBlockSamples];
+
+		// Sign-extended code of sample i
+		inline int32_t value(uint16_t i) const {
+			return ADS1256SampleTraits<Sample>::load(values[i]);
+		}
+
+		inline float volts(uint16_t i, float vref = 2.5f) const {
+			return volts_of(value(i), this->gain(i), vref);
+		}
+	};
+
+	ADS1256CaptureRunner(ADS1256<nCycledChannels, Sample>& adc) : adc_(adc) {}
+
+	// Milliseconds between pauses of the acquisition loop (see ADS1256Task::pause); 0 to never pause
+	uint16_t pause_interval_ms = 100;
+
+	// Starts the acquisition task; the ADS1256 should already be capturing (see beginCapture).  Returns false
+	// if the ADS1256 uses auto_range but this runner does not store per-sample gains.
+	bool start(uint8_t core = 0) {
+		if (running_ || (adc_.auto_range && !perSampleGains)) {
+			return false;
+		}
+		running_ = true;
+		if (!task_.start(run, this, core)) {
+			running_ = false;
+			return false;
+		}
+		return true;
+	}
+
+	// Stops the acquisition task and waits for it to finish; a partially-filled block is discarded
+	void stop() {
+		running_ = false;
+		task_.join();
+	}
+
+	inline bool running() const {
+		return running_;
+	}
+
+	// Returns the oldest completed block, or nullptr if none is ready (the consumer is starved).
+	// The block belongs to the consumer until release() is called.
+	const Block* acquire() {
+		uint32_t released = released_.load(std::memory_order_relaxed);
+		if (published_.load(std::memory_order_acquire) == released) {
+			return nullptr;
+		}
+		return &blocks_[read_slot_];
+	}
+
+	// Returns the block obtained from acquire() to the acquisition task
+	void release() {
+		read_slot_ = read_slot_ + 1 < nBlocks ? read_slot_ + 1 : 0;
+		released_.fetch_add(1, std::memory_order_release);
+	}
+
+	// Total samples dropped because the consumer had not released blocks in time
+	inline uint32_t dropped() const {
+		return dropped_total_.load(std::memory_order_relaxed);
+	}
+
+  private:
+	ADS1256<nCycledChannels, Sample>& adc_;
+	ADS1256Task task_;
+	std::atomic<bool> running_{false};
+
+	Block blocks_[nBlocks];
+	std::atomic<uint32_t> published_{0};
+	std::atomic<uint32_t> released_{0};
+	std::atomic<uint32_t> dropped_total_{0};
+
+	// Block indices are tracked separately from the counters, since counter % nBlocks is not continuous
+	// when the counters wrap (unless nBlocks is a power of two)
+	uint8_t write_slot_ = 0;  // Used only by the acquisition task
+	uint8_t read_slot_ = 0;  // Used only by the consumer
+
+	static void run(void* self) {
+		((ADS1256CaptureRunner*)self)->loop();
+	}
+
+	void loop() {
+		uint32_t dropped = 0;
+		uint16_t n = 0;
+		unsigned long last_pause = millis();
+		while (running_.load(std::memory_order_relaxed)) {
+			adc_.update();
+			if (adc_.new_data != ADS1256_NO_NEW_DATA) {
+				uint8_t channel = adc_.new_data;
+				adc_.new_data = ADS1256_NO_NEW_DATA;
+
+				uint32_t published = published_.load(std::memory_order_relaxed);
+				if (published - released_.load(std::memory_order_acquire) >= nBlocks) {
+					// Every block is waiting on the consumer
+					dropped++;
+					dropped_total_.fetch_add(1, std::memory_order_relaxed);
+				} else {
+					Block& block = blocks_[write_slot_];
+					block.channels[n] = channel;
+					block.values[n] = adc_.values[channel];
+					block.setGain(n, adc_.value_gains[channel]);
+					n++;
+					if (n == nBlockSamples) {
+						block.sequence = published;
+						block.dropped = dropped;
+						block.n_samples = n;
+						write_slot_ = write_slot_ + 1 < nBlocks ? write_slot_ + 1 : 0;
+						published_.store(published + 1, std::memory_order_release);
+						dropped = 0;
+						n = 0;
+					}
+				}
+			}
+			if (pause_interval_ms && millis() - last_pause >= pause_interval_ms) {
+				ADS1256Task::pause();
+				last_pause = millis();
+			}
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef ADS1256_SAMPLE_H
+#define ADS1256_SAMPLE_H
+
+// Storage types for conversion results (the Sample parameter of ADS1256 and ADS1256CaptureRunner).
+//
+// A conversion result is 24 bits, received most significant byte first.  ADS1256SampleTraits<Sample>::store
+// keeps those bytes in a Sample and load returns the value as a sign-extended 24-bit code, so the cost of
+// sign extension is paid when a sample is read rather than on every conversion:
+//   int32_t          4 bytes, sign extended by the shifts in store, so values[] can be read directly
+//   ADS1256Sample24  3 bytes, packed; sign extended by load
+//   int16_t          2 bytes, upper 16 bits only (codes are multiples of 256 after load), for fast channels
+//                    that do not need full resolution
+
+#include <Arduino.h>
+
+struct ADS1256Sample24 {
+	uint8_t bytes[3];  // Most significant first
+};
+
+template<typename Sample>
+struct ADS1256SampleTraits;
+
+template<>
+struct ADS1256SampleTraits<int32_t> {
+	static inline void store(int32_t& sample, uint8_t msb, uint8_t mid, uint8_t lsb) {
+		sample = (int32_t)(((uint32_t)msb << 24) | ((uint32_t)mid << 16) | ((uint32_t)lsb << 8)) >> 8;
+	}
+	static inline int32_t load(const int32_t& sample) {
+		return sample;
+	}
+};
+
+template<>
+struct ADS1256SampleTraits<ADS1256Sample24> {
+	static inline void store(ADS1256Sample24& sample, uint8_t msb, uint8_t mid, uint8_t lsb) {
+		sample.bytes[0] = msb;
+		sample.bytes[1] = mid;
+		sample.bytes[2] = lsb;
+	}
+	static inline int32_t load(const ADS1256Sample24& sample) {
+		return (int32_t)(((uint32_t)sample.bytes[0] << 24) | ((uint32_t)sample.bytes[1] << 16) | ((uint32_t)sample.bytes[2] << 8)) >> 8;
+	}
+};
+
+template<>
+struct ADS1256SampleTraits<int16_t> {
+	static inline void store(int16_t& sample, uint8_t msb, uint8_t mid, uint8_t) {
+		sample = (int16_t)(((uint16_t)msb << 8) | mid);
+	}
+	static inline int32_t load(const int16_t& sample) {
+		return (int32_t)sample * 256;
+	}
+};
+
+#endif
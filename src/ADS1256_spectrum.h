@@ -0,0 +1,270 @@
+#ifndef ADS1256_SPECTRUM_H
+#define ADS1256_SPECTRUM_H
+
+// Block spectral analysis of each cycled channel, e.g. to find 50/60 Hz pickup or switching-supply tones.
+//
+// Samples of each entry of muxes are collected into blocks of nFftSamples (a power of two).  When a block
+// fills, its mean is removed, a Hann window is applied, and an in-place radix-2 FFT is computed.  The
+// report for that channel then lists the noise floor and the nPeaks largest local maxima of the spectrum
+// that stand at least peak_margin_db above it.  The noise floor is estimated from the median bin power, so
+// a strong tone and its leakage do not raise it.  Amplitudes are in dB relative to a full-scale sine (dBFS)
+// and the noise floor is per bin, so it drops by 3 dB each time nFftSamples doubles.
+//
+// The frequency axis is derived from sample_rate_hz, the rate at which each channel is sampled; use
+// configure(adc) to take it from the ADS1256's capture timing model (channelRateHz), which includes the
+// settling time after each multiplexer change and the command overhead of continueCapture().  Set
+// capture_latency_us on the ADS1256 (or sample_rate_hz directly, if measured) for an accurate axis.
+//
+// The FFT assumes evenly spaced samples.  Sensor-detect checks (health_check_interval) take conversion times
+// between samples, so add(adc) places each sample at its conversion index (value_conversions) and linearly
+// interpolates onto an even grid at the average spacing, which matches channelRateHz.  A gap of more than two
+// grid steps (e.g. after a stall or watchdog recovery) discards the partial block.
+
+#include <math.h>
+
+#include "ADS1256_async.h"
+
+#define ADS1256_TWO_PI (6.28318531f)
+
+struct ADS1256SpectralPeak {
+	float frequency_hz;
+	float amplitude_dbfs;
+};
+
+template<uint8_t nPeaks>
+struct ADS1256SpectrumReport {
+	uint32_t block;  // Number of blocks analyzed for this channel, including this one
+	float bin_hz;
+	float noise_floor_dbfs;
+	uint8_t n_peaks;
+	ADS1256SpectralPeak peaks[nPeaks];  // Largest first
+};
+
+template<uint8_t nCycledChannels, uint16_t nFftSamples, uint8_t nPeaks = 4>
+class ADS1256Spectrum {
+	static_assert(nFftSamples >= 8 && (nFftSamples & (nFftSamples - 1)) == 0, "nFftSamples must be a power of two of at least 8");
+
+  public:
+	float sample_rate_hz = 0;
+	float peak_margin_db = 12;  // Local maxima less than this far above the noise floor are not peaks
+
+	template<typename Sample>
+	void configure(const ADS1256<nCycledChannels, Sample>& adc) {
+		sample_rate_hz = adc.channelRateHz();
+	}
+
+	// Adds the sample indicated by adc.new_data, if any, in codes at adc.gain (see normalizedValue, so dBFS
+	// is relative to full scale at adc.gain); returns true if it completed a block, in which case
+	// report(adc.new_data) has been updated.  Call once for each new sample, before new_data is cleared.
+	template<typename Sample>
+	bool add(const ADS1256<nCycledChannels, Sample>& adc) {
+		if (adc.new_data == ADS1256_NO_NEW_DATA) {
+			return false;
+		}
+		uint8_t channel = adc.new_data;
+		float value = adc.normalizedValue(channel);
+		uint32_t conversion = adc.value_conversions[channel];
+		float spacing = (float)nCycledChannels;
+		if (adc.health_check_interval) {
+			spacing = spacing * (adc.health_check_interval + 1) / adc.health_check_interval;
+		}
+
+		bool completed = false;
+		int32_t gap = (int32_t)(conversion - last_conversions_[channel]);
+		if (!started_[channel] || gap <= 0 || gap > 2 * spacing) {
+			n_[channel] = 0;
+			started_[channel] = true;
+			completed = add(channel, value);
+			phases_[channel] = spacing;
+		} else {
+			// Grid points fall at phases_ conversions after the previous sample
+			float last = last_values_[channel];
+			float phase = phases_[channel];
+			for (; phase <= gap; phase += spacing) {
+				completed |= add(channel, last + (value - last) * phase / gap);
+			}
+			phases_[channel] = phase - gap;
+		}
+		last_conversions_[channel] = conversion;
+		last_values_[channel] = value;
+		return completed;
+	}
+
+	// Adds an evenly spaced sample; value is in codes (at a single gain for all samples of a channel)
+	bool add(uint8_t channel, float value) {
+		re_[channel][n_[channel]++] = value;
+		if (n_[channel] < nFftSamples) {
+			return false;
+		}
+		analyze(channel);
+		n_[channel] = 0;
+		return true;
+	}
+
+	// Discards partially-collected blocks, e.g. after changing settings
+	void restart() {
+		for (uint8_t c = 0; c < nCycledChannels; c++) {
+			n_[c] = 0;
+			started_[c] = false;
+		}
+	}
+
+	inline const ADS1256SpectrumReport<nPeaks>& report(uint8_t channel) const {
+		return reports_[channel];
+	}
+
+  private:
+	float re_[nCycledChannels][nFftSamples];
+	float im_[nFftSamples];  // Shared by all channels since analysis happens immediately when a block fills
+	uint16_t n_[nCycledChannels] = {0};
+	bool started_[nCycledChannels] = {0};  // Used by add(adc) to place samples on the grid
+	uint32_t last_conversions_[nCycledChannels] = {0};
+	float last_values_[nCycledChannels] = {0};
+	float phases_[nCycledChannels] = {0};
+	ADS1256SpectrumReport<nPeaks> reports_[nCycledChannels] = {};
+
+	void fft(float* re, float* im) {
+		// Bit-reversal permutation
+		for (uint16_t i = 1, j = 0; i < nFftSamples; i++) {
+			uint16_t bit = nFftSamples >> 1;
+			for (; j & bit; bit >>= 1) {
+				j ^= bit;
+			}
+			j ^= bit;
+			if (i < j) {
+				float t = re[i];
+				re[i] = re[j];
+				re[j] = t;
+				t = im[i];
+				im[i] = im[j];
+				im[j] = t;
+			}
+		}
+
+		// Butterflies
+		for (uint16_t len = 2; len <= nFftSamples; len <<= 1) {
+			float angle = -ADS1256_TWO_PI / len;
+			float w_re = cosf(angle);
+			float w_im = sinf(angle);
+			for (uint16_t i = 0; i < nFftSamples; i += len) {
+				float u_re = 1;
+				float u_im = 0;
+				for (uint16_t k = 0; k < len / 2; k++) {
+					float* a_re = &re[i + k];
+					float* a_im = &im[i + k];
+					float* b_re = &re[i + k + len / 2];
+					float* b_im = &im[i + k + len / 2];
+					float t_re = *b_re * u_re - *b_im * u_im;
+					float t_im = *b_re * u_im + *b_im * u_re;
+					*b_re = *a_re - t_re;
+					*b_im = *a_im - t_im;
+					*a_re += t_re;
+					*a_im += t_im;
+					float next = u_re * w_re - u_im * w_im;
+					u_im = u_re * w_im + u_im * w_re;
+					u_re = next;
+				}
+			}
+		}
+	}
+
+	void analyze(uint8_t channel) {
+		float* re = re_[channel];
+		float* im = im_;
+
+		float mean = 0;
+		for (uint16_t i = 0; i < nFftSamples; i++) {
+			mean += re[i];
+		}
+		mean /= nFftSamples;
+		for (uint16_t i = 0; i < nFftSamples; i++) {
+			re[i] = (re[i] - mean) * (0.5f - 0.5f * cosf(ADS1256_TWO_PI * i / nFftSamples));
+			im[i] = 0;
+		}
+
+		fft(re, im);
+
+		// Convert bins 0..N/2 to sine amplitude in dBFS; the Hann window halves the amplitude of a tone
+		const uint16_t nBins = nFftSamples / 2 + 1;
+		const float scale = 4.0f / nFftSamples / 8388608.0f;
+		for (uint16_t k = 0; k < nBins; k++) {
+			float amplitude = sqrtf(re[k] * re[k] + im[k] * im[k]) * scale;
+			re[k] = 20 * log10f(amplitude > 1e-12f ? amplitude : 1e-12f);
+		}
+
+		ADS1256SpectrumReport<nPeaks>& report = reports_[channel];
+		report.block++;
+		report.bin_hz = sample_rate_hz / nFftSamples;
+		report.n_peaks = 0;
+
+		// Median power of the bins above DC (in im, no longer needed), so tones and their leakage do not
+		// raise the floor; for noise, the mean power per bin is the median divided by ln 2 (+1.59 dB)
+		const uint16_t nNoiseBins = nBins - 2;
+		for (uint16_t k = 0; k < nNoiseBins; k++) {
+			im[k] = re[k + 2];
+		}
+		report.noise_floor_dbfs = select(im, nNoiseBins, nNoiseBins / 2) + 1.59f;
+
+		// Keep the largest local maxima that stand peak_margin_db above the floor (skipping bins 0 and 1,
+		// which hold what remains of DC)
+		for (uint16_t k = 2; k < nBins - 1; k++) {
+			if (re[k] < re[k - 1] || re[k] < re[k + 1] || re[k] < report.noise_floor_dbfs + peak_margin_db) {
+				continue;
+			}
+			// Parabolic interpolation of the peak location between bins
+			float d = re[k - 1] - 2 * re[k] + re[k + 1];
+			float offset = d < 0 ? 0.5f * (re[k - 1] - re[k + 1]) / d : 0;
+			ADS1256SpectralPeak peak;
+			peak.frequency_hz = (k + offset) * report.bin_hz;
+			peak.amplitude_dbfs = re[k] - 0.25f * (re[k - 1] - re[k + 1]) * offset;
+			if (report.n_peaks == nPeaks && peak.amplitude_dbfs <= report.peaks[nPeaks - 1].amplitude_dbfs) {
+				continue;
+			}
+			uint8_t p = report.n_peaks < nPeaks ? report.n_peaks++ : nPeaks - 1;
+			while (p > 0 && report.peaks[p - 1].amplitude_dbfs < peak.amplitude_dbfs) {
+				report.peaks[p] = report.peaks[p - 1];
+				p--;
+			}
+			report.peaks[p] = peak;
+		}
+	}
+
+	// Returns the k-th smallest of values[0..n-1] (reordering them)
+	static float select(float* values, uint16_t n, uint16_t k) {
+		uint16_t left = 0;
+		uint16_t right = n - 1;
+		while (left < right) {
+			float pivot = values[(left + right) / 2];
+			uint16_t i = left;
+			uint16_t j = right;
+			while (i <= j) {
+				while (values[i] < pivot) {
+					i++;
+				}
+				while (values[j] > pivot) {
+					j--;
+				}
+				if (i <= j) {
+					float t = values[i];
+					values[i] = values[j];
+					values[j] = t;
+					i++;
+					if (j == 0) {
+						break;
+					}
+					j--;
+				}
+			}
+			if (k <= j) {
+				right = j;
+			} else if (k >= i) {
+				left = i;
+			} else {
+				break;
+			}
+		}
+		return values[k];
+	}
+};
+
+#endif
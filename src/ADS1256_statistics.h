@@ -0,0 +1,161 @@
+#ifndef ADS1256_STATISTICS_H
+#define ADS1256_STATISTICS_H
+
+// Streaming per-channel statistics with constant memory and no sample buffering.
+//
+// Samples are accumulated as exact integer sums of their offsets from the first sample of the window,
+// which (like Welford's method) avoids the cancellation of the naive sum-of-squares approach: nothing is
+// rounded until a metric is requested.  The 64-bit sum of squares holds at least 65536 samples that swing
+// across the entire 24-bit range, and far more for the small deviations of a noise measurement (up to 2^32 - 1
+// samples); saturated() reports if a window grew too long.
+
+#include <math.h>
+
+#include "ADS1256_async.h"
+
+#define ADS1256_FULL_SCALE_CODES (16777216.0f)
+
+class ADS1256ChannelStatistics {
+  public:
+	void reset() {
+		n_ = 0;
+		sum_ = 0;
+		sum_squares_ = 0;
+		saturated_ = false;
+	}
+
+	void add(int32_t value) {
+		if (n_ == 0) {
+			offset_ = value;
+			min_ = value;
+			max_ = value;
+		} else if (value < min_) {
+			min_ = value;
+		} else if (value > max_) {
+			max_ = value;
+		}
+		int32_t d = value - offset_;
+		uint64_t d2 = (uint64_t)((int64_t)d * d);
+		if (n_ == 0xFFFFFFFFUL || sum_squares_ > 0xFFFFFFFFFFFFFFFFULL - d2) {
+			saturated_ = true;
+			return;
+		}
+		sum_ += d;
+		sum_squares_ += d2;
+		n_++;
+	}
+
+	inline uint32_t count() const {
+		return n_;
+	}
+
+	inline int32_t min() const {
+		return min_;
+	}
+
+	inline int32_t max() const {
+		return max_;
+	}
+
+	// True if samples were ignored because the window was too long to accumulate exactly
+	inline bool saturated() const {
+		return saturated_;
+	}
+
+	float mean() const {
+		if (n_ == 0) {
+			return 0;
+		}
+		return offset_ + (float)sum_ / n_;
+	}
+
+	// Sample variance (n - 1 denominator), in codes squared
+	float variance() const {
+		if (n_ < 2) {
+			return 0;
+		}
+		// sum_squares - sum^2 / n, where sum^2 / n = q * |sum| + r * |sum| / n and the large integer
+		// part is subtracted exactly before converting to float
+		uint64_t a = sum_ < 0 ? -sum_ : sum_;
+		uint64_t q = a / n_;
+		uint64_t r = a % n_;
+		float m2 = (float)(sum_squares_ - q * a) - (float)r * a / n_;
+		return m2 > 0 ? m2 / (n_ - 1) : 0;
+	}
+
+	float standardDeviation() const {
+		return sqrtf(variance());
+	}
+
+	float rms() const {
+		if (n_ == 0) {
+			return 0;
+		}
+		float m = mean();
+		return sqrtf(m * m + variance() * (n_ - 1) / n_);
+	}
+
+	// log2(full scale / RMS noise)
+	float effectiveBits() const {
+		float sigma = standardDeviation();
+		return sigma > 0 ? log2f(ADS1256_FULL_SCALE_CODES / sigma) : 24;
+	}
+
+	// log2(full scale / peak-to-peak noise)
+	float noiseFreeBits() const {
+		if (n_ == 0 || max_ == min_) {
+			return 24;
+		}
+		return log2f(ADS1256_FULL_SCALE_CODES / (float)(max_ - min_));
+	}
+
+  private:
+	uint32_t n_ = 0;
+	int32_t offset_ = 0;
+	int64_t sum_ = 0;
+	uint64_t sum_squares_ = 0;
+	int32_t min_ = 0;
+	int32_t max_ = 0;
+	bool saturated_ = false;
+};
+
+template<uint8_t nCycledChannels>
+class ADS1256Statistics {
+  public:
+	// Adds the sample indicated by adc.new_data, if any, in codes at adc.gain (see normalizedValue); call once
+	// for each new sample, before new_data is cleared
+	template<typename Sample>
+	void add(const ADS1256<nCycledChannels, Sample>& adc) {
+		uint8_t c = adc.new_data;
+		if (c == ADS1256_NO_NEW_DATA) {
+			return;
+		}
+		if (adc.value_gains[c] == adc.gain) {
+			add(c, adc.value(c));
+		} else {
+			// Converted at another gain by auto_range; codes finer than one code at adc.gain are rounded off
+			add(c, (int32_t)floorf(adc.normalizedValue(c) + 0.5f));
+		}
+	}
+
+	inline void add(uint8_t channel, int32_t value) {
+		channels_[channel].add(value);
+	}
+
+	// Starts a new window for every channel
+	void reset() {
+		for (uint8_t c = 0; c < nCycledChannels; c++) {
+			channels_[c].reset();
+		}
+	}
+
+	// Statistics of muxes[channel] in the current window
+	inline const ADS1256ChannelStatistics& channel(uint8_t channel) const {
+		return channels_[channel];
+	}
+
+  private:
+	ADS1256ChannelStatistics channels_[nCycledChannels];
+};
+
+#endif
@@ -0,0 +1,289 @@
+#ifndef ADS1256_TIMING_H
+#define ADS1256_TIMING_H
+
+// Checks the SPI timing in a trace (see ADS1256_trace.h) against the datasheet minimums:
+//   t6: last SCLK of RDATA/RDATAC/RREG command to first SCLK of data read (50 tCLKIN)
+//   t10: last SCLK to CS high (8 tCLKIN)
+//   t11: last SCLK of a command to first SCLK of the next command (4 tCLKIN for RREG, WREG, and RDATA;
+//        24 tCLKIN for RDATAC and SYNC)
+//   t13: between SCLK pulses of an SCLK reset (5 tCLKIN)
+//
+// Gaps are measured from trace timestamps, which are taken after each operation completes, so the duration
+// of the second byte (8 SCLK periods) is subtracted from gaps ending in a transfer.  Timestamps have the
+// resolution of micros() and include the recorder's own overhead, so traces recorded on hardware should
+// be checked on platforms with a microsecond timer; traces recorded on a host (where transfers take no
+// time) should be checked with sclk_hz = 0.
+//
+// Slack is how far each gap exceeds its minimum; the portion of the slack spent in requested delays
+// (delay_t*) is reported as saveable since it could be removed by tightening those delays.
+
+#include "ADS1256_async.h"
+#include "ADS1256_trace.h"
+
+enum class ADS1256TimingParameter : uint8_t {
+	T6 = 0,
+	T10,
+	T11Short,
+	T11Long,
+	T13,
+};
+
+struct ADS1256TimingCheck {
+	ADS1256TimingParameter parameter;
+	uint32_t t_us;  // Time in the trace at the end of the gap
+	float gap_us;
+	float min_us;
+	float delay_us;  // Requested delays within the gap
+};
+
+struct ADS1256TransactionTiming {
+	uint32_t t_us;  // Time in the trace when CS went low (or when the SCLK reset began)
+	uint8_t command;  // First command byte of the transaction
+	bool sclk_reset;  // True if this is an SCLK reset rather than a CS transaction
+	uint8_t checks;
+	uint8_t violations;
+	float slack_us;
+	float saveable_us;
+};
+
+struct ADS1256TimingReport {
+	uint32_t transactions = 0;
+	uint32_t checks = 0;
+	uint32_t violations = 0;
+	float slack_us = 0;
+	float saveable_us = 0;
+	float worst_margin_us = 0;  // Most negative (gap - minimum) found, or 0 if there were no violations
+};
+
+class ADS1256TimingChecker {
+  public:
+	ADS1256TimingChecker(uint8_t pin_cs, uint8_t pin_sclk = ADS1256_NO_PIN) : pin_cs_(pin_cs), pin_sclk_(pin_sclk) {}
+
+	float clkin_hz = 7680000;
+	float sclk_hz = 1920000;  // SPI clock used when recording; 0 if transfers take no time (host traces)
+
+	// Optional callbacks for each gap checked and each completed transaction
+	void (*on_check)(const ADS1256TimingCheck& check, void* context) = nullptr;
+	void (*on_transaction)(const ADS1256TransactionTiming& transaction, void* context) = nullptr;
+	void* context = nullptr;
+
+	float minimumUs(ADS1256TimingParameter parameter) const {
+		switch (parameter) {
+			case ADS1256TimingParameter::T6:
+				return 50 * 1e6f / clkin_hz;
+			case ADS1256TimingParameter::T10:
+				return 8 * 1e6f / clkin_hz;
+			case ADS1256TimingParameter::T11Short:
+				return 4 * 1e6f / clkin_hz;
+			case ADS1256TimingParameter::T11Long:
+				return 24 * 1e6f / clkin_hz;
+			case ADS1256TimingParameter::T13:
+			default:
+				return 5 * 1e6f / clkin_hz;
+		}
+	}
+
+	ADS1256TimingReport check(const uint8_t* trace, size_t size);
+
+  private:
+	enum class Expect : uint8_t {
+		Command = 0,
+		WregCount,
+		WregData,
+		RregCount,
+		ReadData,
+	};
+
+	uint8_t pin_cs_;
+	uint8_t pin_sclk_;
+
+	ADS1256TimingReport report_;
+	ADS1256TransactionTiming transaction_;
+	bool in_transaction_;
+
+	Expect expect_;
+	uint8_t remaining_;
+	bool has_pending_;
+	ADS1256TimingParameter pending_;
+	ADS1256TimingParameter after_read_;
+
+	uint32_t last_spi_us_;
+	bool has_last_spi_;
+	float delay_since_spi_;
+
+	uint32_t sclk_low_us_;
+	bool sclk_low_;
+	float delay_since_sclk_;
+
+	void beginTransaction(uint32_t t_us, bool sclk_reset) {
+		endTransaction();
+		in_transaction_ = true;
+		transaction_.t_us = t_us;
+		transaction_.command = 0xFF;
+		transaction_.sclk_reset = sclk_reset;
+		transaction_.checks = 0;
+		transaction_.violations = 0;
+		transaction_.slack_us = 0;
+		transaction_.saveable_us = 0;
+		expect_ = Expect::Command;
+		has_pending_ = false;
+		has_last_spi_ = false;
+		delay_since_spi_ = 0;
+		sclk_low_ = false;
+		delay_since_sclk_ = 0;
+	}
+
+	void endTransaction() {
+		if (!in_transaction_) {
+			return;
+		}
+		in_transaction_ = false;
+		report_.transactions++;
+		if (on_transaction) {
+			on_transaction(transaction_, context);
+		}
+	}
+
+	void measure(ADS1256TimingParameter parameter, uint32_t t_us, float gap_us, float delay_us) {
+		ADS1256TimingCheck c;
+		c.parameter = parameter;
+		c.t_us = t_us;
+		c.gap_us = gap_us;
+		c.min_us = minimumUs(parameter);
+		c.delay_us = delay_us;
+
+		float margin = gap_us - c.min_us;
+		report_.checks++;
+		transaction_.checks++;
+		if (margin < 0) {
+			report_.violations++;
+			transaction_.violations++;
+			if (margin < report_.worst_margin_us) {
+				report_.worst_margin_us = margin;
+			}
+		} else {
+			float saveable = margin < delay_us ? margin : delay_us;
+			report_.slack_us += margin;
+			report_.saveable_us += saveable;
+			transaction_.slack_us += margin;
+			transaction_.saveable_us += saveable;
+		}
+		if (on_check) {
+			on_check(c, context);
+		}
+	}
+
+	void transfer(uint32_t t_us, uint8_t mosi) {
+		if (has_pending_ && has_last_spi_) {
+			float byte_us = sclk_hz > 0 ? 8 * 1e6f / sclk_hz : 0;
+			measure(pending_, t_us, (float)(t_us - last_spi_us_) - byte_us, delay_since_spi_);
+		}
+		has_pending_ = false;
+
+		switch (expect_) {
+			case Expect::Command:
+				if (transaction_.command == 0xFF) {
+					transaction_.command = mosi;
+				}
+				if ((mosi & 0xF0) == CMD_WREG) {
+					expect_ = Expect::WregCount;
+				} else if ((mosi & 0xF0) == CMD_RREG) {
+					expect_ = Expect::RregCount;
+				} else if (mosi == CMD_RDATA || mosi == CMD_RDATAC) {
+					pending(ADS1256TimingParameter::T6);
+					expect_ = Expect::ReadData;
+					remaining_ = 3;
+					after_read_ = mosi == CMD_RDATA ? ADS1256TimingParameter::T11Short : ADS1256TimingParameter::T11Long;
+				} else if (mosi == CMD_SYNC) {
+					pending(ADS1256TimingParameter::T11Long);
+				}
+				break;
+			case Expect::WregCount:
+				remaining_ = mosi + 1;
+				expect_ = Expect::WregData;
+				break;
+			case Expect::WregData:
+				if (--remaining_ == 0) {
+					pending(ADS1256TimingParameter::T11Short);
+					expect_ = Expect::Command;
+				}
+				break;
+			case Expect::RregCount:
+				pending(ADS1256TimingParameter::T6);
+				remaining_ = mosi + 1;
+				expect_ = Expect::ReadData;
+				after_read_ = ADS1256TimingParameter::T11Short;
+				break;
+			case Expect::ReadData:
+				if (--remaining_ == 0) {
+					pending(after_read_);
+					expect_ = Expect::Command;
+				}
+				break;
+		}
+
+		last_spi_us_ = t_us;
+		has_last_spi_ = true;
+		delay_since_spi_ = 0;
+	}
+
+	inline void pending(ADS1256TimingParameter parameter) {
+		has_pending_ = true;
+		pending_ = parameter;
+	}
+};
+
+inline
+ADS1256TimingReport ADS1256TimingChecker::check(const uint8_t* trace, size_t size) {
+	report_ = ADS1256TimingReport();
+	in_transaction_ = false;
+	has_last_spi_ = false;
+	delay_since_spi_ = 0;
+	sclk_low_ = false;
+	delay_since_sclk_ = 0;
+	ADS1256TraceReader reader(trace, size);
+	ADS1256TraceRecord record;
+	while (reader.next(record)) {
+		switch (record.event) {
+			case ADS1256TraceEvent::SpiTransfer:
+				if (in_transaction_ && !transaction_.sclk_reset) {
+					transfer(record.t_us, record.mosi);
+				}
+				break;
+			case ADS1256TraceEvent::Delay:
+				delay_since_spi_ += record.delay_us;
+				delay_since_sclk_ += record.delay_us;
+				break;
+			case ADS1256TraceEvent::PinWrite:
+				if (record.pin == pin_cs_) {
+					if (record.level == LOW) {
+						beginTransaction(record.t_us, false);
+					} else if (in_transaction_ && !transaction_.sclk_reset) {
+						if (has_last_spi_) {
+							measure(ADS1256TimingParameter::T10, record.t_us, (float)(record.t_us - last_spi_us_), delay_since_spi_);
+						}
+						endTransaction();
+					}
+				} else if (record.pin == pin_sclk_) {
+					if (!in_transaction_ || !transaction_.sclk_reset) {
+						beginTransaction(record.t_us, true);
+					}
+					if (record.level == LOW) {
+						sclk_low_ = true;
+						sclk_low_us_ = record.t_us;
+						delay_since_sclk_ = 0;
+					} else if (sclk_low_) {
+						measure(ADS1256TimingParameter::T13, record.t_us, (float)(record.t_us - sclk_low_us_), delay_since_sclk_);
+						sclk_low_ = false;
+					}
+				}
+				break;
+			default:
+				break;
+		}
+	}
+	endTransaction();
+	return report_;
+}
+
+#endif
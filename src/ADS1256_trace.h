@@ -0,0 +1,249 @@
+#ifndef ADS1256_TRACE_H
+#define ADS1256_TRACE_H
+
+// Compact binary trace of the SPI and pin activity of an ADS1256 instance.
+//
+// To record, define ADS1256_TRACE before including ADS1256_async.h and point the instance's trace field
+// at an ADS1256TraceRecorder.  Each record is a header byte ((event << 1) | level), the microseconds since
+// the previous record as a LEB128 varint, then the event payload:
+//   SpiTransfer: MOSI byte, MISO byte
+//   PinWrite, PinRead: pin number (level in header); reads are only recorded when the level changes
+//   Delay: requested microseconds as a LEB128 varint
+//   BeginTransaction, EndTransaction: nothing
+
+#include <Arduino.h>
+
+enum class ADS1256TraceEvent : uint8_t {
+	SpiTransfer = 0,
+	PinWrite,
+	PinRead,
+	Delay,
+	BeginTransaction,
+	EndTransaction,
+};
+
+struct ADS1256TraceRecord {
+	ADS1256TraceEvent event;
+	uint32_t t_us;  // Since the beginning of the trace
+	uint8_t pin;
+	uint8_t level;
+	uint8_t mosi;
+	uint8_t miso;
+	uint32_t delay_us;
+};
+
+class ADS1256TraceRecorder {
+  public:
+	ADS1256TraceRecorder(uint8_t* buffer, size_t capacity) : buffer_(buffer), capacity_(capacity) {}
+
+	void begin() {
+		size_ = 0;
+		overflowed_ = false;
+		last_read_pin_ = 0xFF;
+		t_last_ = micros();
+	}
+
+	inline const uint8_t* data() const {
+		return buffer_;
+	}
+
+	inline size_t size() const {
+		return size_;
+	}
+
+	// True if events were dropped because the buffer filled up
+	inline bool overflowed() const {
+		return overflowed_;
+	}
+
+	void spiTransfer(uint8_t mosi, uint8_t miso) {
+		if (header(ADS1256TraceEvent::SpiTransfer, 0, 2)) {
+			put(mosi);
+			put(miso);
+		}
+	}
+
+	void pinWrite(uint8_t pin, uint8_t level) {
+		if (header(ADS1256TraceEvent::PinWrite, level, 1)) {
+			put(pin);
+		}
+	}
+
+	void pinRead(uint8_t pin, uint8_t level) {
+		if (pin == last_read_pin_ && level == last_read_level_) {
+			return;
+		}
+		if (header(ADS1256TraceEvent::PinRead, level, 1)) {
+			put(pin);
+			last_read_pin_ = pin;
+			last_read_level_ = level;
+		}
+	}
+
+	void delay(uint32_t us) {
+		if (header(ADS1256TraceEvent::Delay, 0, 5)) {
+			putVarint(us);
+		}
+	}
+
+	void beginTransaction() {
+		header(ADS1256TraceEvent::BeginTransaction, 0, 0);
+	}
+
+	void endTransaction() {
+		header(ADS1256TraceEvent::EndTransaction, 0, 0);
+	}
+
+  private:
+	uint8_t* buffer_;
+	size_t capacity_;
+	size_t size_ = 0;
+	bool overflowed_ = false;
+	unsigned long t_last_ = 0;
+	uint8_t last_read_pin_ = 0xFF;
+	uint8_t last_read_level_ = 0;
+
+	// Writes the header and timestamp if there is room for them plus max_payload bytes
+	bool header(ADS1256TraceEvent event, uint8_t level, uint8_t max_payload) {
+		if (overflowed_ || size_ + 1 + 5 + max_payload > capacity_) {
+			overflowed_ = true;
+			return false;
+		}
+		unsigned long t = micros();
+		put(((uint8_t)event << 1) | (level ? 1 : 0));
+		putVarint(t - t_last_);
+		t_last_ = t;
+		return true;
+	}
+
+	inline void put(uint8_t b) {
+		buffer_[size_++] = b;
+	}
+
+	void putVarint(uint32_t v) {
+		while (v >= 0x80) {
+			put((uint8_t)(v | 0x80));
+			v >>= 7;
+		}
+		put((uint8_t)v);
+	}
+};
+
+class ADS1256TraceReader {
+  public:
+	ADS1256TraceReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+	void rewind() {
+		position_ = 0;
+		t_us_ = 0;
+		truncated_ = false;
+	}
+
+	// Decodes the next record; returns false at the end of the trace (or if it is truncated)
+	bool next(ADS1256TraceRecord& record) {
+		if (position_ >= size_) {
+			return false;
+		}
+		uint8_t h = data_[position_++];
+		uint32_t dt;
+		if (!getVarint(dt)) {
+			return false;
+		}
+		t_us_ += dt;
+		record.event = (ADS1256TraceEvent)(h >> 1);
+		record.level = h & 1;
+		record.t_us = t_us_;
+		switch (record.event) {
+			case ADS1256TraceEvent::SpiTransfer:
+				return get(record.mosi) && get(record.miso);
+			case ADS1256TraceEvent::PinWrite:
+			case ADS1256TraceEvent::PinRead:
+				return get(record.pin);
+			case ADS1256TraceEvent::Delay:
+				return getVarint(record.delay_us);
+			case ADS1256TraceEvent::BeginTransaction:
+			case ADS1256TraceEvent::EndTransaction:
+				return true;
+			default:
+				truncated_ = true;
+				return false;
+		}
+	}
+
+	// True if decoding stopped on a malformed or incomplete record
+	inline bool truncated() const {
+		return truncated_;
+	}
+
+  private:
+	const uint8_t* data_;
+	size_t size_;
+	size_t position_ = 0;
+	uint32_t t_us_ = 0;
+	bool truncated_ = false;
+
+	bool get(uint8_t& b) {
+		if (position_ >= size_) {
+			truncated_ = true;
+			return false;
+		}
+		b = data_[position_++];
+		return true;
+	}
+
+	bool getVarint(uint32_t& v) {
+		v = 0;
+		for (uint8_t shift = 0; shift < 35; shift += 7) {
+			uint8_t b;
+			if (!get(b)) {
+				return false;
+			}
+			v |= (uint32_t)(b & 0x7F) << shift;
+			if (!(b & 0x80)) {
+				return true;
+			}
+		}
+		truncated_ = true;
+		return false;
+	}
+};
+
+struct ADS1256TraceSummary {
+	uint32_t spi_bytes = 0;
+	uint32_t transactions = 0;
+	uint32_t pin_writes = 0;
+	uint32_t delays = 0;
+	uint32_t delay_us = 0;  // Total of all requested delays
+	uint32_t duration_us = 0;  // Time of the last record
+};
+
+// Totals used to compare traces, e.g. to confirm that a change to the capture path did not add SPI bytes
+inline
+ADS1256TraceSummary summarize_trace(const uint8_t* data, size_t size) {
+	ADS1256TraceSummary summary;
+	ADS1256TraceReader reader(data, size);
+	ADS1256TraceRecord record;
+	while (reader.next(record)) {
+		switch (record.event) {
+			case ADS1256TraceEvent::SpiTransfer:
+				summary.spi_bytes++;
+				break;
+			case ADS1256TraceEvent::BeginTransaction:
+				summary.transactions++;
+				break;
+			case ADS1256TraceEvent::PinWrite:
+				summary.pin_writes++;
+				break;
+			case ADS1256TraceEvent::Delay:
+				summary.delays++;
+				summary.delay_us += record.delay_us;
+				break;
+			default:
+				break;
+		}
+		summary.duration_us = record.t_us;
+	}
+	return summary;
+}
+
+#endif
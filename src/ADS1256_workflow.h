@@ -0,0 +1,243 @@
+#ifndef ADS1256_WORKFLOW_H
+#define ADS1256_WORKFLOW_H
+
+// Cooperative workflows: multi-step sequences (reset, write settings, verify, calibrate, capture, ...) written
+// as straight-line code that never blocks, so they can be interleaved with other work in loop().
+//
+// Each step begins an operation and then awaits a condition; the poll_* functions below call update() and
+// report whether the ADS1256 has reached the awaited point.  Two forms are provided:
+//
+//   Protothreads (any compiler): a function returning bool (true when finished) whose body is wrapped in
+//   ADS1256_PT_BEGIN/ADS1256_PT_END and which is called repeatedly from loop().  Local variables do not keep
+//   their values across awaits (use members or statics), switch statements cannot span an await, and only
+//   one await may appear per source line.
+//
+//   Coroutines (C++20): a function returning ADS1256Coroutine that uses co_await on the wait_* awaitables.
+//   poll() resumes it whenever the condition it awaits becomes true or its timeout_ms (if nonzero) passes;
+//   co_await returns true if the condition was met.
+
+#include "ADS1256_async.h"
+
+// True once the ADS1256 is Idle (after beginReset, beginWriteSettings, beginSelfCalibration, or endCapture)
+template<uint8_t nCycledChannels, typename Sample>
+bool poll_idle(ADS1256<nCycledChannels, Sample>& adc) {
+	adc.update();
+	return adc.state() == ADS1256State::Idle;
+}
+
+// True once DRDY is low, so beginWriteSettings, readSettings, beginSelfCalibration, and beginCapture can
+// be called with a timeout of 0
+template<uint8_t nCycledChannels, typename Sample>
+bool poll_data_ready(ADS1256<nCycledChannels, Sample>& adc) {
+	return adc.dataReady();
+}
+
+// True once new_data indicates a sample (while capturing); clear new_data after using it
+template<uint8_t nCycledChannels, typename Sample>
+bool poll_new_data(ADS1256<nCycledChannels, Sample>& adc) {
+	if (adc.new_data == ADS1256_NO_NEW_DATA) {
+		adc.update();
+	}
+	return adc.new_data != ADS1256_NO_NEW_DATA;
+}
+
+struct ADS1256Protothread {
+	uint16_t line = 0;  // Source line of the await to resume at; 0 to start from the beginning
+	unsigned long started_ms = 0;
+	bool timed_out = false;  // Set by ADS1256_PT_AWAIT_TIMEOUT if the condition was not met in time
+
+	inline void restart() {
+		line = 0;
+	}
+
+	inline bool running() const {
+		return line != 0;
+	}
+};
+
+#define ADS1256_PT_BEGIN(pt) switch ((pt).line) { case 0:
+
+#define ADS1256_PT_END(pt) } (pt).line = 0; return true
+
+// Returns false (not finished) until condition is true
+#define ADS1256_PT_AWAIT(pt, condition) \
+	do { \
+		(pt).line = __LINE__; \
+		case __LINE__: \
+		if (!(condition)) { \
+			return false; \
+		} \
+	} while (0)
+
+// Like ADS1256_PT_AWAIT, but gives up after timeout_ms and sets pt.timed_out
+#define ADS1256_PT_AWAIT_TIMEOUT(pt, condition, timeout_ms) \
+	do { \
+		(pt).started_ms = millis(); \
+		(pt).timed_out = false; \
+		(pt).line = __LINE__; \
+		case __LINE__: \
+		if (!(condition)) { \
+			if (millis() - (pt).started_ms < (unsigned long)(timeout_ms)) { \
+				return false; \
+			} \
+			(pt).timed_out = true; \
+		} \
+	} while (0)
+
+// Lets other work run before continuing
+#define ADS1256_PT_YIELD(pt) \
+	do { \
+		(pt).line = __LINE__; \
+		return false; \
+		case __LINE__:; \
+	} while (0)
+
+// Finishes early
+#define ADS1256_PT_EXIT(pt) \
+	do { \
+		(pt).line = 0; \
+		return true; \
+	} while (0)
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#include <coroutine>
+#include <exception>
+
+class ADS1256Coroutine {
+  public:
+	struct promise_type {
+		bool (*condition)(void*) = nullptr;  // Condition awaited while suspended
+		void* context = nullptr;
+
+		ADS1256Coroutine get_return_object() {
+			return ADS1256Coroutine(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+		std::suspend_never initial_suspend() noexcept {
+			return {};
+		}
+		std::suspend_always final_suspend() noexcept {
+			return {};
+		}
+		void return_void() {}
+		void unhandled_exception() {
+			std::terminate();  // poll() has no way to report it
+		}
+	};
+
+	// Not running any coroutine, so done(); assign one to start it
+	ADS1256Coroutine() = default;
+
+	ADS1256Coroutine(ADS1256Coroutine&& other) : handle_(other.handle_) {
+		other.handle_ = nullptr;
+	}
+
+	ADS1256Coroutine& operator=(ADS1256Coroutine&& other) {
+		if (this != &other) {
+			if (handle_) {
+				handle_.destroy();
+			}
+			handle_ = other.handle_;
+			other.handle_ = nullptr;
+		}
+		return *this;
+	}
+
+	ADS1256Coroutine(const ADS1256Coroutine&) = delete;
+	ADS1256Coroutine& operator=(const ADS1256Coroutine&) = delete;
+
+	~ADS1256Coroutine() {
+		if (handle_) {
+			handle_.destroy();
+		}
+	}
+
+	// Resumes the coroutine if the condition it awaits is true; returns true once it has finished
+	bool poll() {
+		if (done()) {
+			return true;
+		}
+		promise_type& promise = handle_.promise();
+		if (promise.condition && !promise.condition(promise.context)) {
+			return false;
+		}
+		promise.condition = nullptr;
+		handle_.resume();
+		return done();
+	}
+
+	inline bool done() const {
+		return !handle_ || handle_.done();
+	}
+
+  private:
+	std::coroutine_handle<promise_type> handle_;
+
+	explicit ADS1256Coroutine(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+};
+
+// Awaitable that suspends an ADS1256Coroutine until condition() returns true, or until timeout_ms has passed
+// (0 to wait indefinitely); co_await returns whether the condition was met
+template<typename Condition>
+struct ADS1256Until {
+	Condition condition;
+	unsigned long timeout_ms = 0;
+	unsigned long started_ms = 0;
+	bool met = false;
+
+	bool await_ready() {
+		started_ms = millis();
+		met = condition();
+		return met;
+	}
+	void await_suspend(std::coroutine_handle<ADS1256Coroutine::promise_type> handle) {
+		handle.promise().condition = check;
+		handle.promise().context = this;
+	}
+	bool await_resume() {
+		return met;
+	}
+
+	static bool check(void* self) {
+		ADS1256Until* until = (ADS1256Until*)self;
+		until->met = until->condition();
+		return until->met || (until->timeout_ms && millis() - until->started_ms >= until->timeout_ms);
+	}
+};
+
+template<typename Condition>
+ADS1256Until<Condition> wait_until(Condition condition, unsigned long timeout_ms = 0) {
+	return ADS1256Until<Condition>{condition, timeout_ms};
+}
+
+template<uint8_t nCycledChannels, typename Sample>
+auto wait_idle(ADS1256<nCycledChannels, Sample>& adc, unsigned long timeout_ms = 0) {
+	return wait_until([&adc]() { return poll_idle(adc); }, timeout_ms);
+}
+
+template<uint8_t nCycledChannels, typename Sample>
+auto wait_data_ready(ADS1256<nCycledChannels, Sample>& adc, unsigned long timeout_ms = 0) {
+	return wait_until([&adc]() { return poll_data_ready(adc); }, timeout_ms);
+}
+
+template<uint8_t nCycledChannels, typename Sample>
+auto wait_new_data(ADS1256<nCycledChannels, Sample>& adc, unsigned long timeout_ms = 0) {
+	return wait_until([&adc]() { return poll_new_data(adc); }, timeout_ms);
+}
+
+inline auto wait_ms(unsigned long ms) {
+	unsigned long started_ms = millis();
+	return wait_until([started_ms, ms]() { return millis() - started_ms >= ms; });
+}
+
+// Lets other work run before continuing
+inline auto yield_once() {
+	bool first = true;
+	return wait_until([first]() mutable {
+		bool ready = !first;
+		first = false;
+		return ready;
+	});
+}
+#endif
+
+#endif